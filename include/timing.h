@@ -0,0 +1,230 @@
+// Timing math that doesn't touch the hardware or the clock's state, kept out
+// of main.cpp so the native environment can test it on the host. Everything
+// here is a pure function of its arguments.
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// Host builds have no esp_attr.h; on the target Arduino.h defines this first.
+#ifndef DRAM_ATTR
+#define DRAM_ATTR
+#endif
+
+constexpr uint16_t PULSES_PER_REVOLUTION = 60;
+
+constexpr uint32_t PULSE_MS = 31;
+
+constexpr uint8_t TICK_COUNT = 59;
+
+enum class TickMode : uint8_t {
+  steady,
+  rush_wait,
+  vetinari,
+  hesitate,
+  stumble,
+  gravity,
+  sprint,
+  crawl,
+};
+
+// --- Tick tables ---
+
+// Vetinari template values are total wall-clock durations (gap + PULSE_MS).
+// Sorted ascending so that after a Fisher-Yates shuffle the distribution is
+// unpredictable but the total always fits within ~58 s, leaving headroom for
+// the NTP wait. Kept in DRAM like tick_durations, so filling the table never
+// reads through the flash cache.
+DRAM_ATTR constexpr uint16_t VETINARI_TEMPLATE[TICK_COUNT] = {
+     534,  550,  552,  561,  565,  574,  574,  619,  641,  649,
+     685,  686,  687,  693,  694,  697,  700,  742,  743,  744,
+     797,  804,  816,  828,  863,  866,  874,  874,  883,  906,
+     920,  957,  981,  984, 1061, 1077, 1096, 1108, 1129, 1190,
+    1192, 1204, 1211, 1227, 1252, 1268, 1310, 1381, 1381, 1387,
+    1410, 1424, 1488, 1629, 1645, 1684, 1729, 1773, 2001,
+};
+
+inline void shuffleTicks(uint16_t* table, uint32_t (*random)()) {
+  for (int i = TICK_COUNT - 1; i > 0; i--) {
+    int j = random() % (i + 1);
+    uint16_t temporary = table[i];
+    table[i] = table[j];
+    table[j] = temporary;
+  }
+}
+
+// Fills a TICK_COUNT-entry table with one minute of tick durations for a
+// timekeeping mode. Each value is the total wall-clock time from one tick to
+// the next. random is esp_random() on the target. Positioning modes don't use
+// the table and leave it untouched.
+inline void fillTickTable(TickMode mode, uint16_t rush_wait_tick_ms,
+                          uint16_t* table, uint32_t (*random)()) {
+  switch (mode) {
+    case TickMode::steady:
+      for (uint8_t i = 0; i < TICK_COUNT; i++) {
+        table[i] = 1000;
+      }
+      break;
+    case TickMode::rush_wait:
+      // 59 pulses in ~55 s leaves ~5 s of idle before the NTP boundary.
+      for (uint8_t i = 0; i < TICK_COUNT; i++) {
+        table[i] = rush_wait_tick_ms;
+      }
+      break;
+    case TickMode::vetinari:
+      memcpy(table, VETINARI_TEMPLATE, sizeof(VETINARI_TEMPLATE));
+      shuffleTicks(table, random);
+      break;
+    case TickMode::hesitate:
+      // 58 ticks at 980ms, 1 tick at 2000ms. Total: 58*980 + 2000 = 58840ms.
+      for (uint8_t i = 0; i < TICK_COUNT; i++) {
+        table[i] = 980;
+      }
+      table[0] = 2000;
+      shuffleTicks(table, random);
+      break;
+    case TickMode::stumble:
+      // 58 ticks at 1010ms, 1 tick at 420ms. Total: 58*1010 + 420 = 59000ms.
+      for (uint8_t i = 0; i < TICK_COUNT; i++) {
+        table[i] = 1010;
+      }
+      table[0] = 420;
+      shuffleTicks(table, random);
+      break;
+    case TickMode::gravity:
+      // Indices 0-29 (12→6, falling): 500ms each — fast, like a hand
+      // accelerating under gravity. Indices 30-58 (6→12, rising): 1520ms each
+      // — slow, like a hand climbing against gravity. No shuffle: the
+      // positional mapping is the whole point. Total: 30*500 + 29*1520 =
+      // 59080ms.
+      for (uint8_t i = 0; i < 30; i++) {
+        table[i] = 500;
+      }
+      for (uint8_t i = 30; i < TICK_COUNT; i++) {
+        table[i] = 1520;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+inline uint32_t tickTableSum(const uint16_t* table) {
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < TICK_COUNT; i++) {
+    sum += table[i];
+  }
+  return sum;
+}
+
+// Longest a minute's ticks may take in total; anything more would overflow
+// into the next minute before the NTP boundary pulse fires.
+constexpr uint32_t TICK_TABLE_MAX_SUM_MS = 59800;
+
+// Range a rescaled tick must stay within: rush_wait's floor, and twice the
+// longest tick any table holds.
+constexpr uint16_t RESCALE_MIN_TICK_MS = 200;
+constexpr uint16_t RESCALE_MAX_TICK_MS = 4000;
+
+// Lets a mode take over mid-minute. table is a full fill for the new mode and
+// from is the next tick to fire; time_left_ms runs from the last pulse to the
+// boundary. Scales table[from..] so those ticks, plus the mode's own share of
+// idle before the boundary, fill time_left_ms: the new pattern keeps its
+// shape and still lands on the boundary. Returns false, leaving the table
+// untouched, if that would push a tick outside RESCALE_MIN/MAX_TICK_MS.
+inline bool rescaleRemainingTicks(uint16_t* table, uint8_t from,
+                                  uint32_t time_left_ms) {
+  uint32_t total_ms = tickTableSum(table);
+  if (from >= TICK_COUNT || total_ms > TICK_TABLE_MAX_SUM_MS) {
+    return false;
+  }
+  uint32_t natural_ms = 60000 - total_ms;
+  for (uint8_t i = from; i < TICK_COUNT; i++) {
+    natural_ms += table[i];
+  }
+  for (uint8_t i = from; i < TICK_COUNT; i++) {
+    uint64_t scaled_ms = (uint64_t)table[i] * time_left_ms / natural_ms;
+    if (scaled_ms < RESCALE_MIN_TICK_MS || scaled_ms > RESCALE_MAX_TICK_MS) {
+      return false;
+    }
+  }
+  for (uint8_t i = from; i < TICK_COUNT; i++) {
+    table[i] = (uint16_t)((uint64_t)table[i] * time_left_ms / natural_ms);
+  }
+  return true;
+}
+
+// Milliseconds since the top of the minute for a time in microseconds since
+// the Unix epoch. The clock runs on UTC, so epoch minutes line up with
+// wall-clock minutes.
+inline uint32_t msIntoMinute(int64_t epoch_us) {
+  return (uint32_t)((epoch_us / 1000) % 60000);
+}
+
+// --- Ramp profiles ---
+
+constexpr uint16_t RAMP_MIN_PEAK_MS = 40;
+constexpr uint16_t RAMP_MAX_START_MS = 2000;
+constexpr uint8_t RAMP_MAX_STEPS = 30;
+
+// Passed as ticks_left to positioningTickMs() when the move has no known end.
+constexpr uint32_t RAMP_DISTANCE_UNKNOWN = UINT32_MAX;
+
+// Acceleration profile for positioning moves. A move starts at start_ms per
+// tick and speeds up over steps ticks to its cruise tick. peak_ms is the
+// fastest cruise tick the rotor can hold once moving. steps == 0 disables
+// ramping.
+struct RampProfile {
+  uint16_t start_ms;
+  uint16_t peak_ms;
+  uint8_t steps;
+};
+
+inline bool rampProfileValid(const RampProfile& ramp) {
+  return ramp.peak_ms >= RAMP_MIN_PEAK_MS && ramp.start_ms >= ramp.peak_ms &&
+         ramp.start_ms <= RAMP_MAX_START_MS && ramp.steps > 0 &&
+         ramp.steps <= RAMP_MAX_STEPS;
+}
+
+// Tick duration at a given step into a ramp, cruising at cruise_ms. The step
+// rate (1 / tick) rises linearly from 1 / start_ms at step 0 to 1 / cruise_ms
+// at step ramp.steps, like a stepper driver's trapezoidal profile. Without a
+// ramp, or when the cruise tick is already slower than the start tick, it is
+// cruise_ms throughout. The result always lies between cruise_ms and
+// start_ms; the products are 64-bit because a 65 s crawl tick times a 2 s
+// start overflows 32 bits.
+inline uint32_t rampTickMs(const RampProfile& ramp, uint32_t cruise_ms,
+                           uint32_t step) {
+  if (ramp.steps == 0 || ramp.start_ms <= cruise_ms || step >= ramp.steps) {
+    return cruise_ms;
+  }
+  return (uint32_t)((uint64_t)ramp.start_ms * cruise_ms * ramp.steps /
+                    ((uint64_t)cruise_ms * ramp.steps +
+                     (uint64_t)(ramp.start_ms - cruise_ms) * step));
+}
+
+// Total duration of the positioning tick that follows a pulse, ticks_done
+// pulses into a move from rest. Accelerates from the start of the move; moves
+// that know their distance (ticks_left pulses to go, counting this tick) also
+// decelerate so the last ticks mirror the first. Short moves never reach
+// cruise_ms and get a triangular profile. Never shorter than PULSE_MS as long
+// as cruise_ms isn't, so the delay after the pulse can't underflow.
+inline uint32_t positioningTickMs(const RampProfile& ramp, uint32_t cruise_ms,
+                                  uint32_t ticks_done, uint32_t ticks_left) {
+  uint32_t step = ticks_done == 0 ? 0 : ticks_done - 1;
+  uint32_t decel_step = ticks_left == 0 ? 0 : ticks_left - 1;
+  if (decel_step < step) {
+    step = decel_step;
+  }
+  return rampTickMs(ramp, cruise_ms, step);
+}
+
+// Duration of a full-revolution move at cruise_ms that accelerates from rest
+// and decelerates into its target, as a calibrate sprint from p59 does.
+inline uint32_t rampRevolutionMs(const RampProfile& ramp, uint32_t cruise_ms) {
+  uint32_t total_ms = 0;
+  for (uint32_t i = 0; i < PULSES_PER_REVOLUTION; i++) {
+    total_ms += positioningTickMs(ramp, cruise_ms, i + 1, PULSES_PER_REVOLUTION - i);
+  }
+  return total_ms;
+}
@@ -6,38 +6,31 @@
 #include <WiFiManager.h>
 #include <WiFiUdp.h>
 #include <driver/gpio.h>
+#include <driver/timer.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+#include <soc/gpio_reg.h>
+#include <soc/soc_memory_layout.h>
 #include <time.h>
 
+#include "timing.h"
+
 constexpr int PIN_COIL_A = 5;
 constexpr int PIN_COIL_B = 6;
-constexpr uint16_t PULSES_PER_REVOLUTION = 60;
-
-constexpr uint32_t PULSE_MS = 31;
+constexpr uint32_t COIL_MASK = BIT(PIN_COIL_A) | BIT(PIN_COIL_B);
 
 constexpr uint32_t SPRINT_DEFAULT_MS = 300;
 constexpr uint32_t CRAWL_DEFAULT_MS = 2000;
 constexpr uint32_t CALIBRATE_SPRINT_MS = 200;
+constexpr uint32_t POSITIONING_MIN_TICK_MS = 100;
 constexpr uint16_t RUSH_WAIT_DEFAULT_MS = 700;
 
-constexpr uint8_t TICK_COUNT = 59;
-
-// Vetinari template values are total wall-clock durations (gap + PULSE_MS).
-// Sorted ascending so that after a Fisher-Yates shuffle the distribution is
-// unpredictable but the total always fits within ~58 s, leaving headroom for
-// the NTP wait.
-constexpr uint16_t VETINARI_TEMPLATE[TICK_COUNT] = {
-     534,  550,  552,  561,  565,  574,  574,  619,  641,  649,
-     685,  686,  687,  693,  694,  697,  700,  742,  743,  744,
-     797,  804,  816,  828,  863,  866,  874,  874,  883,  906,
-     920,  957,  981,  984, 1061, 1077, 1096, 1108, 1129, 1190,
-    1192, 1204, 1211, 1227, 1252, 1268, 1310, 1381, 1381, 1387,
-    1410, 1424, 1488, 1629, 1645, 1684, 1729, 1773, 2001,
-};
-
 // Filled at the start of each minute by fillTickDurations(). Each value is
 // the total wall-clock time from one tick to the next; the loop subtracts
-// PULSE_MS to get the delay after the pulse fires.
-uint16_t tick_durations[TICK_COUNT];
+// PULSE_MS to get the delay after the pulse fires. Placed in DRAM explicitly;
+// checkTimingCoreResidency() verifies it at boot.
+DRAM_ATTR uint16_t tick_durations[TICK_COUNT];
 
 constexpr char NTP_SERVER[] = "pool.ntp.org";
 constexpr long UTC_OFFSET_SECONDS = 0;
@@ -46,6 +39,8 @@ constexpr long UTC_OFFSET_SECONDS = 0;
 
 constexpr char MQTT_TOPIC_MODE_SET[] = "clock/mode/set";
 constexpr char MQTT_TOPIC_MODE_STATE[] = "clock/mode/state";
+constexpr char MQTT_TOPIC_COMMAND[] = "clock/cmd";
+constexpr char MQTT_TOPIC_COMMAND_ACK[] = "clock/cmd/ack";
 constexpr uint16_t MQTT_DEFAULT_PORT = 1883;
 constexpr uint32_t MQTT_RECONNECT_INTERVAL_MS = 5000;
 
@@ -59,19 +54,40 @@ PubSubClient mqtt_client(wifi_client);
 Preferences preferences;
 uint32_t last_mqtt_reconnect_attempt_ms = 0;
 
-// --- Mode selection ---
-
-enum class TickMode : uint8_t {
-  steady,
-  rush_wait,
-  vetinari,
-  hesitate,
-  stumble,
-  gravity,
-  sprint,
-  crawl,
+// --- Radio power ---
+
+// How the WiFi modem sleeps while the clock is ticking. "awake" never sleeps,
+// "light" dozes between DTIM beacons, and "deep" only wakes every
+// radio_listen_interval beacons. Whatever the policy, the radio is held fully
+// awake during wake windows (see isRadioWakeWindow()) and put back to sleep
+// before the next pulse.
+enum class RadioPolicy : uint8_t {
+  awake,
+  light,
+  deep,
 };
 
+constexpr uint8_t RADIO_LISTEN_INTERVAL_DEFAULT = 3;
+constexpr uint32_t RADIO_BEACON_INTERVAL_MS = 102;
+
+// No wake window may start or end closer than this to a pulse, so the radio is
+// never switching power state or draining buffered traffic while the coil is
+// driven.
+constexpr uint32_t RADIO_PULSE_GUARD_MS = 300;
+
+RadioPolicy radio_policy = RadioPolicy::light;
+uint8_t radio_listen_interval = RADIO_LISTEN_INTERVAL_DEFAULT;
+wifi_ps_type_t radio_ps_applied = WIFI_PS_MIN_MODEM;
+
+// Statistics for the "radio" command, reset whenever the policy changes.
+uint32_t radio_stats_start_ms = 0;
+uint32_t radio_stats_last_ms = 0;
+uint32_t radio_awake_ms = 0;
+uint32_t mqtt_last_service_ms = 0;
+uint32_t mqtt_max_service_gap_ms = 0;
+
+// --- Mode selection ---
+
 TickMode current_mode = TickMode::vetinari;
 TickMode pending_mode = TickMode::vetinari;
 bool mode_change_pending = false;
@@ -98,6 +114,14 @@ TickMode last_timekeeping_mode = TickMode::vetinari;
 // Set on every sprint/crawl activation; no default needed.
 uint32_t positioning_tick_ms = 0;
 
+// Acceleration profile for positioning moves, stored per device because it
+// depends on the movement's rotor. Calibrate sprints also slow down into p59
+// with it. Disabled (steps == 0) by default.
+RampProfile ramp_profile = {};
+
+// Pulses fired since the current positioning move started from rest.
+uint16_t ramp_ticks_done = 0;
+
 // Per-tick duration for rush_wait mode. Adjusted via "rush_wait <ms>" MQTT
 // command; bare "rush_wait" resets it to the default.
 uint16_t rush_wait_tick_ms = RUSH_WAIT_DEFAULT_MS;
@@ -127,9 +151,105 @@ bool stop_at_top_pending = false;
 // wrap handles the revolution end correctly (hand lands at p59).
 bool is_calibrate_sprint = false;
 
+// Set while a positioning mode is bridging to a pending timekeeping mode (see
+// planBridge()). bridge_ticks_remaining counts the pulses left until the hand
+// reaches p59, and bridge_boundary_us is the NTP minute boundary the boundary
+// pulse will land on.
+bool bridge_active = false;
+uint8_t bridge_ticks_remaining = 0;
+int64_t bridge_boundary_us = 0;
+
+// millis() when the pending timekeeping mode change was commanded, so the
+// transition latency can be logged when it takes effect. Zero when unknown.
+uint32_t mode_change_requested_ms = 0;
+
+// Set when a commanded or scheduled mode change is applied for the coming
+// minute boundary, so startNewMinute() doesn't replace it with the hourly
+// random pick. Consumed by the next startNewMinute().
+bool boundary_mode_commanded = false;
+
+// Set by the "bench" command and consumed by loop(), so the benchmarks never
+// run inside the MQTT callback (benchLoop() calls mqtt_client.loop()).
+// bench_running is set for the whole run: benchLoop() re-enters loop(), and a
+// "bench" received there must not start the benchmarks inside themselves.
+bool bench_pending = false;
+bool bench_save_pending = false;
+bool bench_running = false;
+
+// --- Profiling ---
+
+// Built with -DSLEIGHT_PROFILE (the sleight-profile environment), PROFILE_SCOPE
+// times the rest of the enclosing scope with the CPU cycle counter and adds it
+// to that section's statistics. In every other build it expands to nothing.
+// Sections nest, so a section's time includes any sections it calls into.
+#ifdef SLEIGHT_PROFILE
+
+enum class ProfileSection : uint8_t {
+  ota,
+  mqtt_connect,
+  mqtt_loop,
+  mqtt_message,
+  log,
+  new_minute,
+  count,
+};
+
+constexpr const char* PROFILE_SECTION_NAMES[] = {
+  "ota", "mqtt_connect", "mqtt_loop", "mqtt_message", "log", "new_minute",
+};
+
+// Bucket i counts samples with a cycle count in [2^(i-1), 2^i); bucket 0 is
+// zero cycles.
+constexpr uint8_t PROFILE_BUCKETS = 33;
+
+struct ProfileStats {
+  uint32_t count;
+  uint64_t total_cycles;
+  uint32_t max_cycles;
+  uint32_t histogram[PROFILE_BUCKETS];
+};
+
+ProfileStats profile_stats[(uint8_t)ProfileSection::count];
+
+class ProfileScope {
+ public:
+  explicit ProfileScope(ProfileSection section)
+      : section_(section), start_(ESP.getCycleCount()) {}
+
+  ~ProfileScope() {
+    uint32_t cycles = ESP.getCycleCount() - start_;
+    ProfileStats& stats = profile_stats[(uint8_t)section_];
+    stats.count++;
+    stats.total_cycles += cycles;
+    stats.max_cycles = max(stats.max_cycles, cycles);
+    stats.histogram[cycles == 0 ? 0 : 32 - __builtin_clz(cycles)]++;
+  }
+
+ private:
+  ProfileSection section_;
+  uint32_t start_;
+};
+
+#define PROFILE_SCOPE(section) ProfileScope profile_scope(ProfileSection::section)
+
+#else
+
+#define PROFILE_SCOPE(section)
+
+#endif
+
 // --- Logging ---
 
+// Set by the benchmarks while they run real command and logging paths, so
+// those don't flood the log. Messages are still formatted; only the output
+// is skipped.
+bool log_muted = false;
+
 static void logMessage(const char* message) {
+  if (log_muted) {
+    return;
+  }
+  PROFILE_SCOPE(log);
   Serial.println(message);
 
   if (WiFi.status() != WL_CONNECTED) {
@@ -154,6 +274,37 @@ static void logMessagef(const char* format, ...) {
   logMessage(buffer);
 }
 
+#ifdef SLEIGHT_PROFILE
+// Logs one line per section that has samples, with the non-empty histogram
+// buckets as <upper bound in cycles>:<count>.
+static void dumpProfile() {
+  uint32_t cpu_mhz = ESP.getCpuFreqMHz();
+  for (uint8_t i = 0; i < (uint8_t)ProfileSection::count; i++) {
+    const ProfileStats& stats = profile_stats[i];
+    if (stats.count == 0) {
+      continue;
+    }
+    char histogram[160] = "";
+    size_t used = 0;
+    for (uint8_t b = 0; b < PROFILE_BUCKETS && used < sizeof(histogram); b++) {
+      if (stats.histogram[b] != 0) {
+        used += snprintf(histogram + used, sizeof(histogram) - used, " <2^%u:%lu", b,
+                         (unsigned long)stats.histogram[b]);
+      }
+    }
+    logMessagef("profile %s count=%lu total=%llu us mean=%lu max=%lu cycles%s",
+                PROFILE_SECTION_NAMES[i], (unsigned long)stats.count,
+                (unsigned long long)(stats.total_cycles / cpu_mhz),
+                (unsigned long)(stats.total_cycles / stats.count),
+                (unsigned long)stats.max_cycles, histogram);
+  }
+}
+
+// Set by the "profile" command and consumed by loop(), so the dump isn't
+// counted against the mqtt_loop section it was requested from.
+bool profile_dump_pending = false;
+#endif
+
 static void logBoundaryPulse() {
   struct timeval tv;
   gettimeofday(&tv, nullptr);
@@ -230,37 +381,384 @@ static bool isTimekeeping(TickMode mode) {
 
 // --- Coil drive ---
 
-static void setCoilIdle() {
-  digitalWrite(PIN_COIL_A, LOW);
-  digitalWrite(PIN_COIL_B, LOW);
+// NVS writes, OTA flash writes and some WiFi work disable the flash cache, and
+// any code or constant data still in flash stalls until they finish, including
+// loop() itself. So loop() never drives the coil directly: it arms a hardware
+// timer alarm for the moment the next pulse should start, and onPulseTimer(),
+// registered with ESP_INTR_FLAG_IRAM so it still runs while the cache is off,
+// starts the pulse and then ends it PULSE_MS later. A flash write can stall
+// loop() but neither delay nor stretch a pulse, as long as loop() armed it
+// before the stall. The pins are driven through the GPIO registers rather than
+// digitalWrite() (which is in flash).
+
+constexpr timer_group_t PULSE_TIMER_GROUP = TIMER_GROUP_0;
+constexpr timer_idx_t PULSE_TIMER = TIMER_0;
+// 80 MHz APB clock / 80 = one count per microsecond.
+constexpr uint32_t PULSE_TIMER_DIVIDER = 80;
+// An alarm armed for a moment already past fires this far ahead instead.
+constexpr uint32_t PULSE_ARM_MIN_LEAD_US = 20;
+// Where the alarm is parked while no pulse is armed.
+constexpr uint64_t PULSE_TIMER_PARK_US = 3600ULL * 1000000;
+
+static void IRAM_ATTR setCoilIdle() {
+  REG_WRITE(GPIO_OUT_W1TC_REG, COIL_MASK);
 }
 
-static void pulseOnce(uint32_t pulse_ms = PULSE_MS) {
+static void IRAM_ATTR setCoilDriven() {
   if (polarity) {
-    digitalWrite(PIN_COIL_A, HIGH);
-    digitalWrite(PIN_COIL_B, LOW);
+    REG_WRITE(GPIO_OUT_W1TS_REG, BIT(PIN_COIL_A));
+    REG_WRITE(GPIO_OUT_W1TC_REG, BIT(PIN_COIL_B));
   } else {
-    digitalWrite(PIN_COIL_A, LOW);
-    digitalWrite(PIN_COIL_B, HIGH);
+    REG_WRITE(GPIO_OUT_W1TC_REG, BIT(PIN_COIL_A));
+    REG_WRITE(GPIO_OUT_W1TS_REG, BIT(PIN_COIL_B));
   }
+}
+
+// Pulse timing statistics, reset by the "jitter" and "stress_nvs" commands.
+// Lateness is how far a table-driven pulse started from tick_durations after
+// the previous pulse; stretch is how much longer than PULSE_MS the coil stayed
+// driven. Timeouts count pulses whose timer alarm never came.
+int64_t last_pulse_start_us = 0;
+uint32_t pulse_count = 0;
+uint32_t pulse_lateness_max_us = 0;
+uint64_t pulse_lateness_total_us = 0;
+uint32_t pulse_lateness_samples = 0;
+uint32_t pulse_stretch_max_us = 0;
+uint32_t pulse_timeouts = 0;
+
+enum class PulsePhase : uint8_t {
+  idle,
+  armed,    // the alarm will start the pulse
+  driving,  // the alarm will end the pulse
+};
 
-  delay(pulse_ms);
+// Shared with onPulseTimer(). Plain globals are in DRAM, so the ISR can read
+// them with the cache off.
+volatile PulsePhase pulse_phase = PulsePhase::idle;
+volatile int64_t pulse_start_us = 0;
+volatile int64_t pulse_end_us = 0;
+// When the armed pulse is due, for completePulse()'s timeout.
+int64_t pulse_due_us = 0;
+// False if the pulse timer could not be set up, or stopped delivering alarms;
+// completePulse() then drives the pulse itself with the ROM busy-wait, which a
+// flash write can delay and stretch.
+bool pulse_timer_ready = false;
+portMUX_TYPE pulse_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Pulse timer alarm: starts an armed pulse and moves the alarm to its end, or
+// ends a driving one and parks the alarm.
+static bool IRAM_ATTR onPulseTimer(void* argument) {
+  uint64_t now = timer_group_get_counter_value_in_isr(PULSE_TIMER_GROUP, PULSE_TIMER);
+  if (pulse_phase == PulsePhase::armed) {
+    setCoilDriven();
+    pulse_start_us = esp_timer_get_time();
+    pulse_phase = PulsePhase::driving;
+    timer_group_set_alarm_value_in_isr(PULSE_TIMER_GROUP, PULSE_TIMER,
+                                       now + PULSE_MS * 1000);
+  } else {
+    setCoilIdle();
+    pulse_end_us = esp_timer_get_time();
+    pulse_phase = PulsePhase::idle;
+    timer_group_set_alarm_value_in_isr(PULSE_TIMER_GROUP, PULSE_TIMER,
+                                       now + PULSE_TIMER_PARK_US);
+  }
+  return false;
+}
+
+// Starts the pulse timer free-running at one count per microsecond, with its
+// alarm parked.
+static void setupPulseTimer() {
+  timer_config_t config = {};
+  config.alarm_en = TIMER_ALARM_DIS;
+  config.counter_en = TIMER_PAUSE;
+  config.intr_type = TIMER_INTR_LEVEL;
+  config.counter_dir = TIMER_COUNT_UP;
+  config.auto_reload = TIMER_AUTORELOAD_DIS;
+  config.divider = PULSE_TIMER_DIVIDER;
+  esp_err_t err = timer_init(PULSE_TIMER_GROUP, PULSE_TIMER, &config);
+  if (err == ESP_OK) {
+    err = timer_isr_callback_add(PULSE_TIMER_GROUP, PULSE_TIMER, onPulseTimer,
+                                 nullptr, ESP_INTR_FLAG_IRAM);
+  }
+  if (err == ESP_OK) {
+    timer_set_counter_value(PULSE_TIMER_GROUP, PULSE_TIMER, 0);
+    err = timer_start(PULSE_TIMER_GROUP, PULSE_TIMER);
+  }
+  if (err != ESP_OK) {
+    logMessagef("Pulse timer unavailable (%s); pulses are busy-waited.",
+                esp_err_to_name(err));
+    return;
+  }
+  pulse_timer_ready = true;
+}
+
+// Arms the next pulse to start at start_us (esp_timer_get_time() time), or
+// as soon as possible if that has passed. completePulse() must follow.
+static void armPulse(int64_t start_us) {
+  pulse_due_us = start_us;
+  if (!pulse_timer_ready) {
+    return;
+  }
+  portENTER_CRITICAL(&pulse_mux);
+  uint64_t now_count = 0;
+  timer_get_counter_value(PULSE_TIMER_GROUP, PULSE_TIMER, &now_count);
+  int64_t lead_us = start_us - esp_timer_get_time();
+  if (lead_us < (int64_t)PULSE_ARM_MIN_LEAD_US) {
+    lead_us = PULSE_ARM_MIN_LEAD_US;
+  }
+  pulse_phase = PulsePhase::armed;
+  timer_set_alarm_value(PULSE_TIMER_GROUP, PULSE_TIMER, now_count + (uint64_t)lead_us);
+  timer_set_alarm(PULSE_TIMER_GROUP, PULSE_TIMER, TIMER_ALARM_EN);
+  portEXIT_CRITICAL(&pulse_mux);
+}
+
+// Disarms a pulse that has not started yet. Returns false if it already has,
+// in which case completePulse() must still follow.
+static bool cancelPulse() {
+  if (!pulse_timer_ready) {
+    return true;
+  }
+  portENTER_CRITICAL(&pulse_mux);
+  bool cancelled = pulse_phase == PulsePhase::armed;
+  if (cancelled) {
+    pulse_phase = PulsePhase::idle;
+    timer_set_alarm(PULSE_TIMER_GROUP, PULSE_TIMER, TIMER_ALARM_DIS);
+  }
+  portEXIT_CRITICAL(&pulse_mux);
+  return cancelled;
+}
+
+// Gives up on the pulse timer after an alarm failed to arrive within twice
+// PULSE_MS of when it was due: releases the coil, stops the timer and falls
+// back to busy-waited pulses. Returns whether the pulse had started.
+static bool abandonPulseTimer() {
+  portENTER_CRITICAL(&pulse_mux);
+  bool started = pulse_phase == PulsePhase::driving;
   setCoilIdle();
+  pulse_end_us = esp_timer_get_time();
+  pulse_phase = PulsePhase::idle;
+  timer_set_alarm(PULSE_TIMER_GROUP, PULSE_TIMER, TIMER_ALARM_DIS);
+  timer_pause(PULSE_TIMER_GROUP, PULSE_TIMER);
+  portEXIT_CRITICAL(&pulse_mux);
+  pulse_timer_ready = false;
+  pulse_timeouts++;
+  logMessagef("Pulse timer alarm missed (pulse %s); pulses are busy-waited "
+              "from now on.", started ? "not ended" : "not started");
+  return started;
+}
+
+// Waits for the armed pulse to start and end, then records it. Without the
+// pulse timer, drives the pulse here instead.
+static void completePulse() {
+  bool driven = false;
+  if (pulse_timer_ready) {
+    int64_t give_up_us = pulse_due_us + 2 * (int64_t)PULSE_MS * 1000;
+    int64_t until_end_us = pulse_due_us + (int64_t)PULSE_MS * 1000 - esp_timer_get_time();
+    if (until_end_us > 1000) {
+      delay((uint32_t)(until_end_us / 1000));
+    }
+    while (pulse_phase != PulsePhase::idle) {
+      if (esp_timer_get_time() > give_up_us) {
+        driven = abandonPulseTimer();
+        break;
+      }
+      delay(1);
+    }
+    if (pulse_timer_ready) {
+      driven = true;
+    }
+  }
+  if (!driven) {
+    int64_t until_start_us = pulse_due_us - esp_timer_get_time();
+    if (until_start_us > 0) {
+      delay((uint32_t)((until_start_us + 999) / 1000));
+    }
+    pulse_start_us = esp_timer_get_time();
+    setCoilDriven();
+    esp_rom_delay_us(PULSE_MS * 1000);
+    setCoilIdle();
+    pulse_end_us = esp_timer_get_time();
+  }
+
+  int32_t stretch_us =
+      (int32_t)(pulse_end_us - pulse_start_us - (int64_t)PULSE_MS * 1000);
+  if (stretch_us > (int32_t)pulse_stretch_max_us) {
+    pulse_stretch_max_us = (uint32_t)stretch_us;
+  }
+  last_pulse_start_us = pulse_start_us;
+  pulse_count++;
   polarity = !polarity;
   pulse_index++;
 }
 
+// Fires one pulse now.
+static void pulseOnce() {
+  armPulse(esp_timer_get_time());
+  completePulse();
+}
+
+// Records how late a table-driven tick fired relative to the previous pulse,
+// which started at previous_start_us. Called just after completePulse() with
+// the tick's total duration.
+static void recordTickLateness(int64_t previous_start_us, uint16_t duration_ms) {
+  if (previous_start_us == 0) {
+    // No previous pulse to measure from, e.g. right after "start".
+    return;
+  }
+  int64_t late_us = last_pulse_start_us - previous_start_us -
+                    (int64_t)duration_ms * 1000;
+  uint32_t magnitude_us = (uint32_t)(late_us < 0 ? -late_us : late_us);
+  pulse_lateness_max_us = max(pulse_lateness_max_us, magnitude_us);
+  pulse_lateness_total_us += magnitude_us;
+  pulse_lateness_samples++;
+}
+
+static void resetPulseStats() {
+  pulse_count = 0;
+  pulse_lateness_max_us = 0;
+  pulse_lateness_total_us = 0;
+  pulse_lateness_samples = 0;
+  pulse_stretch_max_us = 0;
+  pulse_timeouts = 0;
+}
+
+static void logPulseStats(const char* label) {
+  logMessagef("%s: %lu pulses, tick lateness max=%lu us mean=%lu us, "
+              "pulse stretch max=%lu us, %lu timeout(s)",
+              label, (unsigned long)pulse_count,
+              (unsigned long)pulse_lateness_max_us,
+              (unsigned long)(pulse_lateness_samples == 0
+                                  ? 0
+                                  : pulse_lateness_total_us / pulse_lateness_samples),
+              (unsigned long)pulse_stretch_max_us, (unsigned long)pulse_timeouts);
+}
+
+// Verifies at boot that the timing core ended up in internal RAM. A linker
+// script or attribute change that moves any of it back to flash would
+// reintroduce cache-miss stalls silently, so this logs loudly instead.
+static bool checkTimingCoreResidency() {
+  bool ok = true;
+  if (!esp_ptr_in_iram((const void*)&onPulseTimer)) {
+    logMessage("Residency check: onPulseTimer() is not in IRAM.");
+    ok = false;
+  }
+  if (!esp_ptr_in_iram((const void*)&setCoilIdle)) {
+    logMessage("Residency check: setCoilIdle() is not in IRAM.");
+    ok = false;
+  }
+  if (!esp_ptr_in_iram((const void*)&setCoilDriven)) {
+    logMessage("Residency check: setCoilDriven() is not in IRAM.");
+    ok = false;
+  }
+  if (!esp_ptr_in_dram(tick_durations)) {
+    logMessage("Residency check: tick_durations is not in DRAM.");
+    ok = false;
+  }
+  if (!esp_ptr_in_dram(VETINARI_TEMPLATE)) {
+    logMessage("Residency check: VETINARI_TEMPLATE is not in DRAM.");
+    ok = false;
+  }
+  if (ok) {
+    logMessage("Residency check: timing core is in internal RAM.");
+  }
+  return ok;
+}
+
+// --- NVS stress test ---
+
+// "stress_nvs <seconds>" measures the pulse statistics for that long with the
+// clock ticking quietly, then again while a separate task hammers NVS, and
+// checks that the writes made pulses neither later nor longer. The task runs
+// at the same priority as loop(), so its flash writes land wherever the
+// scheduler puts them, including right before a pulse.
+constexpr uint32_t STRESS_NVS_MAX_SECONDS = 600;
+// How much the worst lateness or stretch may grow under the writes: interrupt
+// latency, not a cache stall, which would cost milliseconds.
+constexpr uint32_t STRESS_NVS_MARGIN_US = 100;
+
+bool stress_nvs_running = false;
+bool stress_nvs_writing = false;
+volatile bool stress_nvs_done = false;
+volatile uint32_t stress_nvs_writes = 0;
+uint32_t stress_nvs_seconds = 0;
+uint32_t stress_nvs_started_ms = 0;
+uint32_t stress_nvs_quiet_lateness_max_us = 0;
+uint32_t stress_nvs_quiet_stretch_max_us = 0;
+uint32_t stress_nvs_quiet_samples = 0;
+
+static void stressNvsTask(void* parameter) {
+  Preferences stress_preferences;
+  stress_preferences.begin("stress", false);
+  uint32_t start = millis();
+  while (millis() - start < stress_nvs_seconds * 1000) {
+    stress_preferences.putUInt("counter", stress_nvs_writes);
+    stress_nvs_writes++;
+    vTaskDelay(pdMS_TO_TICKS(1));
+  }
+  stress_preferences.clear();
+  stress_preferences.end();
+  stress_nvs_done = true;
+  vTaskDelete(nullptr);
+}
+
+// Called on every loop() iteration. Starts the writes when the quiet phase
+// is over and compares the two phases when they finish.
+static void serviceStressNvs() {
+  if (!stress_nvs_running) {
+    return;
+  }
+  if (!stress_nvs_writing) {
+    if (millis() - stress_nvs_started_ms < stress_nvs_seconds * 1000) {
+      return;
+    }
+    logPulseStats("stress_nvs quiet");
+    stress_nvs_quiet_lateness_max_us = pulse_lateness_max_us;
+    stress_nvs_quiet_stretch_max_us = pulse_stretch_max_us;
+    stress_nvs_quiet_samples = pulse_lateness_samples;
+    resetPulseStats();
+    stress_nvs_writes = 0;
+    stress_nvs_done = false;
+    if (xTaskCreate(stressNvsTask, "stress_nvs", 4096, nullptr, 1, nullptr) != pdPASS) {
+      logMessage("stress_nvs: could not start task.");
+      stress_nvs_running = false;
+      return;
+    }
+    stress_nvs_writing = true;
+    return;
+  }
+  if (!stress_nvs_done) {
+    return;
+  }
+  stress_nvs_running = false;
+  stress_nvs_writing = false;
+  logMessagef("stress_nvs: %lu writes.", (unsigned long)stress_nvs_writes);
+  logPulseStats("stress_nvs");
+  if (stress_nvs_quiet_samples == 0 || pulse_lateness_samples == 0) {
+    logMessage("stress_nvs: no table-driven ticks to compare; run it while ticking.");
+    return;
+  }
+  bool later = pulse_lateness_max_us >
+               stress_nvs_quiet_lateness_max_us + STRESS_NVS_MARGIN_US;
+  bool longer = pulse_stretch_max_us >
+                stress_nvs_quiet_stretch_max_us + STRESS_NVS_MARGIN_US;
+  bool pass = !later && !longer && pulse_timeouts == 0;
+  logMessagef("stress_nvs: %s, lateness max %lu us (quiet %lu us), stretch max "
+              "%lu us (quiet %lu us).",
+              pass ? "PASS" : "FAIL", (unsigned long)pulse_lateness_max_us,
+              (unsigned long)stress_nvs_quiet_lateness_max_us,
+              (unsigned long)pulse_stretch_max_us,
+              (unsigned long)stress_nvs_quiet_stretch_max_us);
+}
+
 // Returns false and sets stopped=true if the sum of tick_durations exceeds
-// 59800 ms, which would cause the 59 ticks to overflow into the next minute
-// before the NTP boundary pulse fires.
+// TICK_TABLE_MAX_SUM_MS, which would cause the 59 ticks to overflow into the
+// next minute before the NTP boundary pulse fires.
 static bool validateTickDurationsSum() {
-  uint32_t sum = 0;
-  for (uint8_t i = 0; i < TICK_COUNT; i++) {
-    sum += tick_durations[i];
-  }
-  if (sum > 59800) {
-    logMessagef("tick_durations sum %lu exceeds 59800 for mode %s, stopping.",
-                (unsigned long)sum, modeToString(current_mode));
+  uint32_t sum = tickTableSum(tick_durations);
+  if (sum > TICK_TABLE_MAX_SUM_MS) {
+    logMessagef("tick_durations sum %lu exceeds %lu for mode %s, stopping.",
+                (unsigned long)sum, (unsigned long)TICK_TABLE_MAX_SUM_MS,
+                modeToString(current_mode));
     stopped = true;
     return false;
   }
@@ -268,70 +766,7 @@ static bool validateTickDurationsSum() {
 }
 
 static void fillTickDurations() {
-  switch (current_mode) {
-    case TickMode::steady:
-      for (uint8_t i = 0; i < TICK_COUNT; i++) {
-        tick_durations[i] = 1000;
-      }
-      break;
-    case TickMode::rush_wait:
-      // 59 pulses in ~55 s leaves ~5 s of idle before the NTP boundary.
-      for (uint8_t i = 0; i < TICK_COUNT; i++) {
-        tick_durations[i] = rush_wait_tick_ms;
-      }
-      break;
-    case TickMode::vetinari:
-      memcpy(tick_durations, VETINARI_TEMPLATE, sizeof(tick_durations));
-      for (int i = TICK_COUNT - 1; i > 0; i--) {
-        int j = esp_random() % (i + 1);
-        uint16_t temporary = tick_durations[i];
-        tick_durations[i] = tick_durations[j];
-        tick_durations[j] = temporary;
-      }
-      break;
-    case TickMode::hesitate:
-      // 58 ticks at 980ms, 1 tick at 2000ms. Total: 58*980 + 2000 = 58840ms.
-      for (uint8_t i = 0; i < TICK_COUNT; i++) {
-        tick_durations[i] = 980;
-      }
-      tick_durations[0] = 2000;
-      for (int i = TICK_COUNT - 1; i > 0; i--) {
-        int j = esp_random() % (i + 1);
-        uint16_t temporary = tick_durations[i];
-        tick_durations[i] = tick_durations[j];
-        tick_durations[j] = temporary;
-      }
-      break;
-    case TickMode::stumble:
-      // 58 ticks at 1010ms, 1 tick at 420ms. Total: 58*1010 + 420 = 59000ms.
-      for (uint8_t i = 0; i < TICK_COUNT; i++) {
-        tick_durations[i] = 1010;
-      }
-      tick_durations[0] = 420;
-      for (int i = TICK_COUNT - 1; i > 0; i--) {
-        int j = esp_random() % (i + 1);
-        uint16_t temporary = tick_durations[i];
-        tick_durations[i] = tick_durations[j];
-        tick_durations[j] = temporary;
-      }
-      break;
-    case TickMode::gravity:
-      // Indices 0-29 (12→6, falling): 500ms each — fast, like a hand
-      // accelerating under gravity. Indices 30-58 (6→12, rising): 1520ms each
-      // — slow, like a hand climbing against gravity. No shuffle: the
-      // positional mapping is the whole point. Total: 30*500 + 29*1520 =
-      // 59080ms.
-      for (uint8_t i = 0; i < 30; i++) {
-        tick_durations[i] = 500;
-      }
-      for (uint8_t i = 30; i < TICK_COUNT; i++) {
-        tick_durations[i] = 1520;
-      }
-      break;
-    default:
-      // Positioning modes (sprint/crawl) don't use the tick_durations table.
-      break;
-  }
+  fillTickTable(current_mode, rush_wait_tick_ms, tick_durations, esp_random);
   validateTickDurationsSum();
 }
 
@@ -350,14 +785,154 @@ static bool waitForNtpSync(uint32_t timeout_ms) {
   return false;
 }
 
+// Microseconds since the Unix epoch, according to NTP.
+static int64_t getEpochUs() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// When the last pulse started, in microseconds since the Unix epoch.
+static int64_t lastPulseEpochUs() {
+  return getEpochUs() - (esp_timer_get_time() - last_pulse_start_us);
+}
+
 // Returns how many milliseconds have elapsed since the top of the current
 // minute, according to NTP.
 static uint32_t getMsIntoMinute() {
-  struct timeval tv;
-  gettimeofday(&tv, nullptr);
-  struct tm timeinfo;
-  localtime_r(&tv.tv_sec, &timeinfo);
-  return (uint32_t)timeinfo.tm_sec * 1000 + (uint32_t)(tv.tv_usec / 1000);
+  return msIntoMinute(getEpochUs());
+}
+
+// --- Radio power ---
+
+static const char* radioPolicyToString(RadioPolicy policy) {
+  switch (policy) {
+    case RadioPolicy::awake:
+      return "awake";
+    case RadioPolicy::light:
+      return "light";
+    case RadioPolicy::deep:
+      return "deep";
+  }
+  return "unknown";
+}
+
+static bool stringToRadioPolicy(const char* str, RadioPolicy& out) {
+  if (strcmp(str, "awake") == 0) {
+    out = RadioPolicy::awake;
+    return true;
+  }
+  if (strcmp(str, "light") == 0) {
+    out = RadioPolicy::light;
+    return true;
+  }
+  if (strcmp(str, "deep") == 0) {
+    out = RadioPolicy::deep;
+    return true;
+  }
+  return false;
+}
+
+static wifi_ps_type_t radioPolicyPsType(RadioPolicy policy) {
+  switch (policy) {
+    case RadioPolicy::awake:
+      return WIFI_PS_NONE;
+    case RadioPolicy::light:
+      return WIFI_PS_MIN_MODEM;
+    case RadioPolicy::deep:
+      return WIFI_PS_MAX_MODEM;
+  }
+  return WIFI_PS_MIN_MODEM;
+}
+
+// True when the radio may be held fully awake: while the clock is stopped with
+// no boundary pulse coming, or in the idle gap between tick 58 and the NTP
+// boundary pulse (or the start_at_minute pulse). The window is shrunk by
+// RADIO_PULSE_GUARD_MS on both sides so no pulse ever lands inside it.
+static bool isRadioWakeWindow() {
+  if (esp_timer_get_time() - last_pulse_start_us <
+      (int64_t)(RADIO_PULSE_GUARD_MS + PULSE_MS) * 1000) {
+    return false;
+  }
+  if (stopped && !start_at_minute_pending) {
+    return true;
+  }
+  bool waiting_for_boundary =
+      start_at_minute_pending ||
+      (!stopped && isTimekeeping(current_mode) && pulse_index == 59);
+  if (!waiting_for_boundary) {
+    return false;
+  }
+  uint32_t ms = getMsIntoMinute();
+  return ms >= RADIO_PULSE_GUARD_MS && ms < 60000 - RADIO_PULSE_GUARD_MS;
+}
+
+// Called on every loop() iteration. Only calls into the WiFi driver when the
+// wanted power-save mode actually changes.
+static void updateRadioPower() {
+  uint32_t now = millis();
+  if (radio_ps_applied == WIFI_PS_NONE) {
+    radio_awake_ms += now - radio_stats_last_ms;
+  }
+  radio_stats_last_ms = now;
+
+  wifi_ps_type_t wanted = radioPolicyPsType(radio_policy);
+  if (wanted != WIFI_PS_NONE && isRadioWakeWindow()) {
+    wanted = WIFI_PS_NONE;
+  }
+  if (wanted == radio_ps_applied) {
+    return;
+  }
+  esp_wifi_set_ps(wanted);
+  radio_ps_applied = wanted;
+}
+
+static void resetRadioStats() {
+  radio_stats_start_ms = millis();
+  radio_stats_last_ms = radio_stats_start_ms;
+  radio_awake_ms = 0;
+  mqtt_max_service_gap_ms = 0;
+}
+
+// The listen interval is only read by the AP at association time, so this
+// reconnects if it differs from the value the driver currently holds. Only
+// called from setup(), before the clock starts ticking.
+static void applyRadioListenInterval() {
+  wifi_config_t config;
+  if (esp_wifi_get_config(WIFI_IF_STA, &config) != ESP_OK) {
+    return;
+  }
+  if (config.sta.listen_interval == radio_listen_interval) {
+    return;
+  }
+  config.sta.listen_interval = radio_listen_interval;
+  esp_wifi_set_config(WIFI_IF_STA, &config);
+  WiFi.reconnect();
+  WiFi.waitForConnectResult(10000);
+}
+
+// Average current cannot be measured from inside the chip, so this reports
+// what can: the share of time the radio was held fully awake, the longest gap
+// between mqtt_client.loop() calls, and the worst-case command latency that
+// follows from it plus the modem sleep interval.
+static void logRadioStats() {
+  uint32_t elapsed_ms = millis() - radio_stats_start_ms;
+  uint32_t awake_permille =
+      elapsed_ms == 0 ? 0 : (uint32_t)((uint64_t)radio_awake_ms * 1000 / elapsed_ms);
+  uint32_t sleep_ms = 0;
+  if (radio_policy == RadioPolicy::light) {
+    sleep_ms = RADIO_BEACON_INTERVAL_MS;
+  } else if (radio_policy == RadioPolicy::deep) {
+    sleep_ms = RADIO_BEACON_INTERVAL_MS * radio_listen_interval;
+  }
+  logMessagef("radio policy=%s listen=%u awake=%lu.%lu%% over %lus "
+              "service_gap_max=%lums command_latency_max=%lums",
+              radioPolicyToString(radio_policy), radio_listen_interval,
+              (unsigned long)(awake_permille / 10),
+              (unsigned long)(awake_permille % 10),
+              (unsigned long)(elapsed_ms / 1000),
+              (unsigned long)mqtt_max_service_gap_ms,
+              (unsigned long)(mqtt_max_service_gap_ms + sleep_ms));
 }
 
 // --- MQTT ---
@@ -386,21 +961,165 @@ static void selectRandomTimekeepingMode() {
   publishCurrentMode();
 }
 
-static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
-  if (strcmp(topic, MQTT_TOPIC_MODE_SET) != 0) {
+// --- Ramp profiles ---
+
+// Smallest tick "sprint <ms>" and "crawl <ms>" accept. A ramp profile lets the
+// rotor reach faster ticks than it could start at, so its peak replaces the
+// constant-rate floor.
+static uint32_t positioningMinTickMs() {
+  return ramp_profile.steps > 0 ? ramp_profile.peak_ms : POSITIONING_MIN_TICK_MS;
+}
+
+// Total duration of the positioning tick that follows the pulse just fired
+// (see positioningTickMs() in timing.h). Calibrate sprints know their distance
+// to p59, so they decelerate into it.
+static uint32_t currentPositioningTickMs() {
+  uint32_t ticks_left = RAMP_DISTANCE_UNKNOWN;
+  if (is_calibrate_sprint) {
+    ticks_left = pulse_index < PULSES_PER_REVOLUTION
+                     ? PULSES_PER_REVOLUTION - pulse_index
+                     : 0;
+  }
+  return positioningTickMs(ramp_profile, positioning_tick_ms, ramp_ticks_done,
+                           ticks_left);
+}
+
+// Logs the ramp profile together with how long a full-revolution calibrate
+// sprint takes with it, compared with the constant CALIBRATE_SPRINT_MS rate.
+static void logRampProfile() {
+  if (ramp_profile.steps == 0) {
+    logMessagef("Ramp off: full revolution takes %lu ms at %lu ms per tick.",
+                (unsigned long)(CALIBRATE_SPRINT_MS * PULSES_PER_REVOLUTION),
+                (unsigned long)CALIBRATE_SPRINT_MS);
     return;
   }
+  uint32_t total_ms = rampRevolutionMs(ramp_profile, ramp_profile.peak_ms);
+  logMessagef("Ramp start=%u peak=%u steps=%u: full revolution takes %lu ms "
+              "(constant %lu ms per tick: %lu ms).",
+              ramp_profile.start_ms, ramp_profile.peak_ms, ramp_profile.steps,
+              (unsigned long)total_ms,
+              (unsigned long)CALIBRATE_SPRINT_MS,
+              (unsigned long)(CALIBRATE_SPRINT_MS * PULSES_PER_REVOLUTION));
+}
+
+// --- Scheduled commands ---
+
+// Commands sent as "at <epoch_seconds>[.<ms>] <command>" are kept here, sorted
+// by deadline, and applied by serviceAgenda() when their deadline passes.
+// Fixed capacity so scheduling never allocates.
+constexpr uint8_t AGENDA_CAPACITY = 8;
+constexpr uint8_t COMMAND_MAX_LENGTH = 48;
 
-  char buffer[32];
-  unsigned int copy_length = min(length, (unsigned int)(sizeof(buffer) - 1));
-  memcpy(buffer, payload, copy_length);
-  buffer[copy_length] = '\0';
+struct ScheduledCommand {
+  int64_t deadline_us;
+  char command[COMMAND_MAX_LENGTH];
+};
+
+ScheduledCommand agenda[AGENDA_CAPACITY];
+uint8_t agenda_count = 0;
+
+// Parses "<epoch_seconds>[.<ms>] <command>" and inserts it into the agenda,
+// keeping it sorted by deadline. Commands with equal deadlines keep the order
+// they were received in. Returns false if the command was rejected.
+static bool scheduleCommand(const char* args) {
+  char* endptr;
+  int64_t seconds = (int64_t)strtoull(args, &endptr, 10);
+  // Anything past 2100-01-01 is a typo (or a millisecond timestamp).
+  if (endptr == args || seconds > 4102444800LL) {
+    logMessagef("Unknown command: at %s", args);
+    return false;
+  }
+  int64_t fraction_us = 0;
+  if (*endptr == '.') {
+    // Up to millisecond precision; further digits are ignored.
+    int64_t scale = 100000;
+    endptr++;
+    while (*endptr >= '0' && *endptr <= '9') {
+      fraction_us += (*endptr - '0') * scale;
+      scale /= 10;
+      endptr++;
+    }
+    fraction_us -= fraction_us % 1000;
+  }
+  if (*endptr != ' ' || *(endptr + 1) == '\0') {
+    logMessagef("Unknown command: at %s", args);
+    return false;
+  }
+  const char* command = endptr + 1;
+  if (strncmp(command, "at ", 3) == 0) {
+    logMessage("Scheduled commands cannot be nested.");
+    return false;
+  }
+
+  int64_t deadline_us = seconds * 1000000 + fraction_us;
+  if (deadline_us <= getEpochUs()) {
+    logMessagef("Scheduled command rejected, deadline has passed: %s", command);
+    return false;
+  }
+  if (agenda_count == AGENDA_CAPACITY) {
+    logMessagef("Scheduled command rejected, agenda full: %s", command);
+    return false;
+  }
+
+  uint8_t slot = agenda_count;
+  while (slot > 0 && agenda[slot - 1].deadline_us > deadline_us) {
+    agenda[slot] = agenda[slot - 1];
+    slot--;
+  }
+  agenda[slot].deadline_us = deadline_us;
+  strncpy(agenda[slot].command, command, COMMAND_MAX_LENGTH - 1);
+  agenda[slot].command[COMMAND_MAX_LENGTH - 1] = '\0';
+  agenda_count++;
+  logMessagef("Scheduled at %lld.%03lld: %s", (long long)(deadline_us / 1000000),
+              (long long)(deadline_us % 1000000 / 1000), command);
+  return true;
+}
+
+static void logAgenda() {
+  logMessagef("Agenda: %u of %u entries.", agenda_count, AGENDA_CAPACITY);
+  for (uint8_t i = 0; i < agenda_count; i++) {
+    logMessagef("  %lld.%03lld: %s", (long long)(agenda[i].deadline_us / 1000000),
+                (long long)(agenda[i].deadline_us % 1000000 / 1000),
+                agenda[i].command);
+  }
+}
+
+// --- Command handling ---
+
+enum class CommandResult : uint8_t {
+  applied = 0,
+  queued = 1,
+  rejected = 2,
+  superseded = 3,
+};
+
+// Handles one text command. Shared by the MQTT callback, the binary command
+// protocol and the scheduled command agenda. May modify buffer while parsing.
+// Returns queued for timekeeping mode changes, which take effect with a later
+// pulse (the next tick, the minute boundary, or the boundary a stopped clock
+// starts on), and for scheduled commands; rejected for anything that was not
+// understood or could not be carried out; and applied otherwise.
+static CommandResult handleCommand(char* buffer) {
+  if (strncmp(buffer, "at ", 3) == 0) {
+    return scheduleCommand(buffer + 3) ? CommandResult::queued : CommandResult::rejected;
+  }
+
+  if (strcmp(buffer, "agenda") == 0) {
+    logAgenda();
+    return CommandResult::applied;
+  }
+
+  if (strcmp(buffer, "agenda clear") == 0) {
+    agenda_count = 0;
+    logMessage("Agenda cleared.");
+    return CommandResult::applied;
+  }
 
   if (strcmp(buffer, "stop") == 0) {
     stopped = true;
     start_at_minute_pending = false;
     logMessage("Clock stopped.");
-    return;
+    return CommandResult::applied;
   }
 
   if (strcmp(buffer, "start") == 0) {
@@ -408,22 +1127,150 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
     start_at_minute_pending = false;
     pulse_index = 0;
     is_calibrate_sprint = false;
+    bridge_active = false;
+    last_pulse_start_us = 0;
+    ramp_ticks_done = 0;
     logMessage("Clock started immediately.");
-    return;
+    return CommandResult::applied;
   }
 
   if (strcmp(buffer, "start_at_minute") == 0) {
     start_at_minute_pending = true;
     stop_at_top_pending = false;
     logMessage("Clock will start at next minute boundary.");
-    return;
+    return CommandResult::applied;
   }
 
   if (strcmp(buffer, "stop_at_top") == 0) {
     stop_at_top_pending = true;
     start_at_minute_pending = false;
     logMessage("Clock will stop at top of next revolution.");
-    return;
+    return CommandResult::applied;
+  }
+
+  if (strcmp(buffer, "radio") == 0) {
+    logRadioStats();
+    return CommandResult::applied;
+  }
+
+  if (strncmp(buffer, "radio ", 6) == 0) {
+    // "radio <policy> [listen_interval]". The policy applies on the next
+    // loop() iteration; the listen interval is negotiated with the AP at
+    // association, so it applies from the next boot.
+    char* policy_name = buffer + 6;
+    char* listen_str = strchr(policy_name, ' ');
+    if (listen_str != nullptr) {
+      *listen_str = '\0';
+      listen_str++;
+    }
+    RadioPolicy requested_policy;
+    if (!stringToRadioPolicy(policy_name, requested_policy)) {
+      logMessagef("Unknown radio policy: %s", policy_name);
+      return CommandResult::rejected;
+    }
+    radio_policy = requested_policy;
+    if (listen_str != nullptr) {
+      uint32_t requested_interval = (uint32_t)strtoul(listen_str, nullptr, 10);
+      radio_listen_interval =
+          (uint8_t)(requested_interval < 1 ? 1 : min(requested_interval, (uint32_t)100));
+    }
+    preferences.begin("clock", false);
+    preferences.putUChar("radio_policy", (uint8_t)radio_policy);
+    preferences.putUChar("radio_listen", radio_listen_interval);
+    preferences.end();
+    resetRadioStats();
+    logMessagef("Radio policy set to: %s (listen interval %u from next boot)",
+                radioPolicyToString(radio_policy), radio_listen_interval);
+    return CommandResult::applied;
+  }
+
+  if (strcmp(buffer, "bench") == 0 || strcmp(buffer, "bench save") == 0) {
+    if (!stopped || start_at_minute_pending) {
+      logMessage("bench: stop the clock first.");
+      return CommandResult::rejected;
+    }
+    if (bench_running || bench_pending) {
+      logMessage("bench: already running.");
+      return CommandResult::rejected;
+    }
+    bench_pending = true;
+    bench_save_pending = strcmp(buffer, "bench save") == 0;
+    return CommandResult::applied;
+  }
+
+  if (strcmp(buffer, "profile") == 0 || strcmp(buffer, "profile reset") == 0) {
+#ifdef SLEIGHT_PROFILE
+    if (strcmp(buffer, "profile reset") == 0) {
+      memset(profile_stats, 0, sizeof(profile_stats));
+      logMessage("Profile reset.");
+    } else {
+      profile_dump_pending = true;
+    }
+    return CommandResult::applied;
+#else
+    logMessage("Profiling is not compiled in; build the sleight-profile environment.");
+    return CommandResult::rejected;
+#endif
+  }
+
+  if (strcmp(buffer, "ramp") == 0) {
+    logRampProfile();
+    return CommandResult::applied;
+  }
+
+  if (strncmp(buffer, "ramp ", 5) == 0) {
+    // "ramp <start_ms> <peak_ms> <steps>" or "ramp off". Applies to the next
+    // positioning move; a move already in progress keeps its cruise tick.
+    if (strcmp(buffer + 5, "off") == 0) {
+      ramp_profile = {};
+    } else {
+      char* endptr;
+      uint32_t start_ms = (uint32_t)strtoul(buffer + 5, &endptr, 10);
+      uint32_t peak_ms = (uint32_t)strtoul(endptr, &endptr, 10);
+      uint32_t steps = (uint32_t)strtoul(endptr, &endptr, 10);
+      RampProfile requested = {
+        (uint16_t)min(start_ms, (uint32_t)UINT16_MAX),
+        (uint16_t)min(peak_ms, (uint32_t)UINT16_MAX),
+        (uint8_t)min(steps, (uint32_t)UINT8_MAX),
+      };
+      if (!rampProfileValid(requested)) {
+        logMessagef("Unknown command: %s", buffer);
+        return CommandResult::rejected;
+      }
+      ramp_profile = requested;
+    }
+    preferences.begin("clock", false);
+    preferences.putUShort("ramp_start", ramp_profile.start_ms);
+    preferences.putUShort("ramp_peak", ramp_profile.peak_ms);
+    preferences.putUChar("ramp_steps", ramp_profile.steps);
+    preferences.end();
+    logRampProfile();
+    return CommandResult::applied;
+  }
+
+  if (strcmp(buffer, "jitter") == 0) {
+    logPulseStats("jitter");
+    resetPulseStats();
+    return CommandResult::applied;
+  }
+
+  if (strncmp(buffer, "stress_nvs ", 11) == 0) {
+    if (stress_nvs_running) {
+      logMessage("stress_nvs: already running.");
+      return CommandResult::rejected;
+    }
+    uint32_t seconds = (uint32_t)strtoul(buffer + 11, nullptr, 10);
+    if (seconds == 0 || seconds > STRESS_NVS_MAX_SECONDS) {
+      logMessagef("Unknown command: %s", buffer);
+      return CommandResult::rejected;
+    }
+    stress_nvs_seconds = seconds;
+    stress_nvs_started_ms = millis();
+    stress_nvs_running = true;
+    resetPulseStats();
+    logMessagef("stress_nvs: measuring quietly for %lu s, then writing NVS for %lu s.",
+                (unsigned long)seconds, (unsigned long)seconds);
+    return CommandResult::applied;
   }
 
   if (strncmp(buffer, "calibrate ", 10) == 0) {
@@ -431,11 +1278,11 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
     uint32_t position = (uint32_t)strtoul(buffer + 10, &endptr, 10);
     if (endptr == buffer + 10) {
       logMessagef("Unknown command: %s", buffer);
-      return;
+      return CommandResult::rejected;
     }
     if (position >= 60) {
       logMessagef("Unknown command: %s", buffer);
-      return;
+      return CommandResult::rejected;
     }
     if (position == 59) {
       // Already at p59, which is the desired pre-boundary calibrate position.
@@ -444,6 +1291,7 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
       stop_at_top_pending = false;
       mode_change_pending = false;
       is_calibrate_sprint = false;
+      bridge_active = false;
       logMessage("Calibrate: at p59, waiting for minute boundary.");
     } else {
       // Set pulse_index to one step past the known position so the sprint loop
@@ -463,7 +1311,11 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
         delay_ms = (uint32_t)strtoul(endptr + 1, &delay_endptr, 10);
         has_custom_delay = (delay_endptr != endptr + 1);
       }
-      positioning_tick_ms = has_custom_delay ? delay_ms + PULSE_MS : CALIBRATE_SPRINT_MS;
+      if (has_custom_delay) {
+        positioning_tick_ms = delay_ms + PULSE_MS;
+      } else {
+        positioning_tick_ms = ramp_profile.steps > 0 ? ramp_profile.peak_ms : CALIBRATE_SPRINT_MS;
+      }
 
       current_mode = TickMode::sprint;
       stopped = false;
@@ -471,7 +1323,10 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
       stop_at_top_pending = false;
       pending_mode = last_timekeeping_mode;
       mode_change_pending = true;
+      mode_change_requested_ms = 0;
       is_calibrate_sprint = true;
+      bridge_active = false;
+      ramp_ticks_done = 0;
       if (has_custom_delay) {
         logMessagef("Calibrate: sprinting from p%02u to p59 at %ums delay, then resuming %s.",
                     position, delay_ms, modeToString(last_timekeeping_mode));
@@ -481,7 +1336,7 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
       }
       publishCurrentMode();
     }
-    return;
+    return CommandResult::applied;
   }
 
   // Check for positioning modes with an optional tick-duration parameter
@@ -493,15 +1348,15 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
     parameterized_mode = TickMode::sprint;
     has_parameterized_mode = true;
     uint32_t requested_ms = (uint32_t)strtoul(buffer + 7, nullptr, 10);
-    positioning_tick_ms = requested_ms < 100 ? 100 : requested_ms;
+    positioning_tick_ms = max(requested_ms, positioningMinTickMs());
   } else if (strncmp(buffer, "crawl ", 6) == 0) {
     parameterized_mode = TickMode::crawl;
     has_parameterized_mode = true;
     uint32_t requested_ms = (uint32_t)strtoul(buffer + 6, nullptr, 10);
-    positioning_tick_ms = requested_ms < 100 ? 100 : requested_ms;
+    positioning_tick_ms = max(requested_ms, positioningMinTickMs());
   } else if (strncmp(buffer, "rush_wait ", 10) == 0) {
-    // rush_wait is a timekeeping mode, so it must queue at revolution
-    // boundaries rather than activate immediately like sprint/crawl.
+    // rush_wait is a timekeeping mode, so it queues like the other
+    // timekeeping modes rather than activating immediately like sprint/crawl.
     uint32_t requested_ms = (uint32_t)strtoul(buffer + 10, nullptr, 10);
     rush_wait_tick_ms = (uint16_t)(requested_ms < 200 ? 200 : requested_ms);
     if (stopped) {
@@ -509,29 +1364,32 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
       last_timekeeping_mode = TickMode::rush_wait;
       mode_change_pending = false;
       start_at_minute_pending = true;
+      boundary_mode_commanded = true;
       logMessagef("Mode changed to: rush_wait (starting at next minute boundary, tick=%ums)",
                   rush_wait_tick_ms);
       publishCurrentMode();
     } else {
       pending_mode = TickMode::rush_wait;
       mode_change_pending = true;
-      logMessagef("Mode change queued: rush_wait (applies at next revolution, tick=%ums)",
-                  rush_wait_tick_ms);
+      mode_change_requested_ms = millis();
+      logMessagef("Mode change queued: rush_wait (tick=%ums)", rush_wait_tick_ms);
     }
-    return;
+    return CommandResult::queued;
   }
 
   if (has_parameterized_mode) {
     current_mode = parameterized_mode;
     mode_change_pending = false;
     is_calibrate_sprint = false;
+    bridge_active = false;
+    ramp_ticks_done = 0;
     stopped = false;
     start_at_minute_pending = false;
     stop_at_top_pending = false;
     logMessagef("Mode changed to: %s (immediate, tick=%ums)",
                 modeToString(parameterized_mode), positioning_tick_ms);
     publishCurrentMode();
-    return;
+    return CommandResult::applied;
   }
 
   TickMode requested;
@@ -541,12 +1399,18 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
       // synchronization. Any pending blocking state is superseded: the user
       // explicitly chose a positioning mode, so waiting for a minute boundary
       // or a stop-at-top would prevent it from ever starting.
-      positioning_tick_ms = (requested == TickMode::sprint)
-                                ? SPRINT_DEFAULT_MS
-                                : CRAWL_DEFAULT_MS;
+      if (requested == TickMode::sprint) {
+        // With a ramp profile the rotor can cruise faster than the
+        // conservative constant-rate default.
+        positioning_tick_ms = ramp_profile.steps > 0 ? ramp_profile.peak_ms : SPRINT_DEFAULT_MS;
+      } else {
+        positioning_tick_ms = CRAWL_DEFAULT_MS;
+      }
       current_mode = requested;
       mode_change_pending = false;
       is_calibrate_sprint = false;
+      bridge_active = false;
+      ramp_ticks_done = 0;
       stopped = false;
       start_at_minute_pending = false;
       stop_at_top_pending = false;
@@ -564,9 +1428,11 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
       if (isTimekeeping(current_mode)) last_timekeeping_mode = current_mode;
       mode_change_pending = false;
       start_at_minute_pending = true;
+      boundary_mode_commanded = true;
       logMessagef("Mode changed to: %s (starting at next minute boundary)",
                    modeToString(requested));
       publishCurrentMode();
+      return CommandResult::queued;
     } else {
       if (requested == TickMode::rush_wait) {
         // Bare "rush_wait" always reverts to the default tick duration.
@@ -574,15 +1440,368 @@ static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
       }
       pending_mode = requested;
       mode_change_pending = true;
-      logMessagef("Mode change queued: %s (applies at next revolution)",
-                   buffer);
+      mode_change_requested_ms = millis();
+      logMessagef("Mode change queued: %s", buffer);
+      return CommandResult::queued;
+    }
+    return CommandResult::applied;
+  }
+  logMessagef("Unknown command: %s", buffer);
+  return CommandResult::rejected;
+}
+
+// --- Binary command protocol ---
+
+// Commands on MQTT_TOPIC_COMMAND are binary frames: a version byte, a count
+// byte, then count 8-byte records of <seq:u16> <opcode:u8> <arg8:u8>
+// <arg32:u32>, all little-endian. Each record is translated to the equivalent
+// text command and run through handleCommand(), so both protocols share one
+// set of semantics. Every record is acknowledged on MQTT_TOPIC_COMMAND_ACK
+// with a frame of the same shape holding 19-byte records of <seq:u16>
+// <status:u8> <received_us:i64> <applied_us:i64>, timestamps in microseconds
+// since the epoch (applied_us is 0 unless status is applied).
+//
+// Mode changes that queue for the revolution boundary are acknowledged when
+// they take effect, or as superseded if another command replaces them first.
+constexpr uint8_t BINARY_PROTOCOL_VERSION = 1;
+constexpr uint8_t BINARY_MAX_BATCH = 8;
+constexpr uint8_t BINARY_COMMAND_SIZE = 8;
+constexpr uint8_t BINARY_ACK_SIZE = 19;
+
+enum class BinaryOpcode : uint8_t {
+  stop = 0x01,
+  start = 0x02,
+  start_at_minute = 0x03,
+  stop_at_top = 0x04,
+  mode = 0x10,       // arg8: TickMode, arg32: tick ms for sprint/crawl/rush_wait (0 = default)
+  calibrate = 0x11,  // arg8: position, arg32: delay ms (0 = default)
+};
+
+// A timekeeping mode change that a binary ack or a scheduled command's skew
+// report is still waiting on. The change takes effect with the first pulse
+// the new mode drives: the next table tick after a mid-minute takeover, or the
+// boundary pulse that starts its first minute (when applied at the boundary,
+// parked at p59 after a bridge, or sent while stopped). A command that
+// replaces or cancels it before then makes it superseded.
+struct ModeChangeReport {
+  bool active;
+  // False while the change waits in pending_mode; true once it is
+  // current_mode and waiting for its first pulse.
+  bool applied;
+  TickMode mode;
+  bool has_ack;
+  uint16_t ack_seq;
+  int64_t received_us;
+  bool scheduled;
+  int64_t deadline_us;
+};
+
+ModeChangeReport mode_change_report = {};
+
+static void writeLe(uint8_t* out, uint64_t value, uint8_t bytes) {
+  for (uint8_t i = 0; i < bytes; i++) {
+    out[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+static uint32_t readLe(const uint8_t* in, uint8_t bytes) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < bytes; i++) {
+    value |= (uint32_t)in[i] << (8 * i);
+  }
+  return value;
+}
+
+static void writeAckRecord(uint8_t* out, uint16_t seq, CommandResult status,
+                           int64_t received_us, int64_t applied_us) {
+  writeLe(out, seq, 2);
+  out[2] = (uint8_t)status;
+  writeLe(out + 3, (uint64_t)received_us, 8);
+  writeLe(out + 11, (uint64_t)applied_us, 8);
+}
+
+static void publishAcks(const uint8_t* records, uint8_t count) {
+  if (!mqtt_client.connected() || count == 0) {
+    return;
+  }
+  uint8_t frame[2 + BINARY_MAX_BATCH * BINARY_ACK_SIZE];
+  frame[0] = BINARY_PROTOCOL_VERSION;
+  frame[1] = count;
+  memcpy(frame + 2, records, count * BINARY_ACK_SIZE);
+  mqtt_client.publish(MQTT_TOPIC_COMMAND_ACK, frame, 2 + count * BINARY_ACK_SIZE);
+}
+
+// Starts following the mode change that handleCommand() just returned queued
+// for. The caller fills in what to report.
+static ModeChangeReport& trackModeChange() {
+  mode_change_report = {};
+  mode_change_report.active = true;
+  mode_change_report.applied = !mode_change_pending;
+  mode_change_report.mode = mode_change_pending ? pending_mode : current_mode;
+  return mode_change_report;
+}
+
+// Sends the deferred ack and/or logs the scheduling skew for the followed
+// mode change. effect_us is when its first pulse started; it is ignored when
+// the change was superseded.
+static void resolveModeChangeReport(CommandResult status, int64_t effect_us) {
+  if (!mode_change_report.active) {
+    return;
+  }
+  ModeChangeReport report = mode_change_report;
+  mode_change_report.active = false;
+  bool applied = status == CommandResult::applied;
+  const char* outcome = applied ? "applied" : "superseded";
+  int64_t at_us = applied ? effect_us : getEpochUs();
+  if (report.has_ack) {
+    uint8_t record[BINARY_ACK_SIZE];
+    writeAckRecord(record, report.ack_seq, status, report.received_us,
+                   applied ? effect_us : 0);
+    publishAcks(record, 1);
+    logMessagef("Command %u %s %ld us after receipt.", report.ack_seq, outcome,
+                (long)(at_us - report.received_us));
+  }
+  if (report.scheduled) {
+    logMessagef("Scheduled mode change %s (skew %ld us)", outcome,
+                (long)(at_us - report.deadline_us));
+  }
+}
+
+// Called after every pulse a timekeeping mode drives. If the followed mode
+// change is current, this was its first pulse. The hourly random pick is the
+// only thing that can change the mode without a command, so a mismatch here
+// means it was overridden.
+static void reportModeChangeEffect() {
+  if (!mode_change_report.active || !mode_change_report.applied) {
+    return;
+  }
+  resolveModeChangeReport(current_mode == mode_change_report.mode
+                              ? CommandResult::applied
+                              : CommandResult::superseded,
+                          lastPulseEpochUs());
+}
+
+// Runs a text command from any source. If it replaced or cancelled a mode
+// change that a binary or scheduled command is still waiting on, that command
+// is reported as superseded.
+static CommandResult dispatchCommand(char* buffer) {
+  bool is_schedule = strncmp(buffer, "at ", 3) == 0;
+  CommandResult result = handleCommand(buffer);
+  if (mode_change_report.active) {
+    bool requeued = result == CommandResult::queued && !is_schedule;
+    bool replaced = mode_change_report.applied
+                        ? current_mode != mode_change_report.mode
+                        : !mode_change_pending || pending_mode != mode_change_report.mode;
+    if (requeued || replaced) {
+      resolveModeChangeReport(CommandResult::superseded, 0);
+    }
+  }
+  return result;
+}
+
+// Translates one binary record to its text command. Returns false for an
+// unknown opcode or an out-of-range argument.
+static bool binaryToText(const uint8_t* record, char* out, size_t size) {
+  BinaryOpcode opcode = (BinaryOpcode)record[2];
+  uint8_t arg8 = record[3];
+  uint32_t arg32 = readLe(record + 4, 4);
+  switch (opcode) {
+    case BinaryOpcode::stop:
+      snprintf(out, size, "stop");
+      return true;
+    case BinaryOpcode::start:
+      snprintf(out, size, "start");
+      return true;
+    case BinaryOpcode::start_at_minute:
+      snprintf(out, size, "start_at_minute");
+      return true;
+    case BinaryOpcode::stop_at_top:
+      snprintf(out, size, "stop_at_top");
+      return true;
+    case BinaryOpcode::mode: {
+      if (arg8 > (uint8_t)TickMode::crawl) {
+        return false;
+      }
+      TickMode mode = (TickMode)arg8;
+      bool takes_duration = mode == TickMode::sprint || mode == TickMode::crawl ||
+                            mode == TickMode::rush_wait;
+      if (takes_duration && arg32 != 0) {
+        snprintf(out, size, "%s %lu", modeToString(mode), (unsigned long)arg32);
+      } else {
+        snprintf(out, size, "%s", modeToString(mode));
+      }
+      return true;
+    }
+    case BinaryOpcode::calibrate:
+      if (arg32 != 0) {
+        snprintf(out, size, "calibrate %u %lu", arg8, (unsigned long)arg32);
+      } else {
+        snprintf(out, size, "calibrate %u", arg8);
+      }
+      return true;
+  }
+  return false;
+}
+
+static void handleBinaryCommands(const uint8_t* payload, unsigned int length,
+                                 int64_t received_us) {
+  if (length < 2 || payload[0] != BINARY_PROTOCOL_VERSION || payload[1] == 0 ||
+      payload[1] > BINARY_MAX_BATCH ||
+      length != 2 + (unsigned int)payload[1] * BINARY_COMMAND_SIZE) {
+    logMessagef("Malformed binary command (%u bytes).", length);
+    return;
+  }
+
+  // The payload points into PubSubClient's buffer, which publishing an ack
+  // would overwrite, so work from a copy.
+  uint8_t frame[2 + BINARY_MAX_BATCH * BINARY_COMMAND_SIZE];
+  memcpy(frame, payload, length);
+  uint8_t count = frame[1];
+
+  uint8_t acks[BINARY_MAX_BATCH * BINARY_ACK_SIZE];
+  uint8_t ack_count = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const uint8_t* record = frame + 2 + i * BINARY_COMMAND_SIZE;
+    uint16_t seq = (uint16_t)readLe(record, 2);
+    char text[COMMAND_MAX_LENGTH];
+    CommandResult result = CommandResult::rejected;
+    if (binaryToText(record, text, sizeof(text))) {
+      result = dispatchCommand(text);
+    } else {
+      logMessagef("Unknown binary command %u: opcode 0x%02x", seq, record[2]);
+    }
+
+    if (result == CommandResult::queued) {
+      ModeChangeReport& report = trackModeChange();
+      report.has_ack = true;
+      report.ack_seq = seq;
+      report.received_us = received_us;
+      continue;
+    }
+    writeAckRecord(acks + ack_count * BINARY_ACK_SIZE, seq, result, received_us,
+                   result == CommandResult::applied ? getEpochUs() : 0);
+    ack_count++;
+  }
+  publishAcks(acks, ack_count);
+}
+
+// Applies every agenda entry whose deadline has passed, in deadline order, and
+// logs how late each one actually took effect.
+static void serviceAgenda() {
+  while (agenda_count > 0) {
+    int64_t now_us = getEpochUs();
+    if (agenda[0].deadline_us > now_us) {
+      return;
+    }
+    ScheduledCommand due = agenda[0];
+    agenda_count--;
+    memmove(&agenda[0], &agenda[1], agenda_count * sizeof(ScheduledCommand));
+    // handleCommand() may modify its buffer, so keep due.command intact for
+    // the log line, which goes out after the command has taken effect.
+    char command[COMMAND_MAX_LENGTH];
+    memcpy(command, due.command, sizeof(command));
+    switch (dispatchCommand(command)) {
+      case CommandResult::applied:
+        logMessagef("Scheduled command applied: %s (skew %ld us)", due.command,
+                    (long)(now_us - due.deadline_us));
+        break;
+      case CommandResult::queued: {
+        // A timekeeping mode change; its skew is logged when it takes effect.
+        ModeChangeReport& report = trackModeChange();
+        report.scheduled = true;
+        report.deadline_us = due.deadline_us;
+        logMessagef("Scheduled command queued: %s", due.command);
+        break;
+      }
+      default:
+        logMessagef("Scheduled command rejected: %s", due.command);
+        break;
+    }
+  }
+}
+
+// Like delay(), but wakes at agenda deadlines that fall inside the delay and
+// applies them exactly on time. Returns false (leaving the rest of the delay
+// unspent) if a scheduled command stopped the clock or changed the mode or
+// positioning tick, so the caller can drop the tick it was timing.
+static bool delayWithAgenda(uint32_t ms) {
+  uint32_t start = millis();
+  while (true) {
+    uint32_t elapsed = millis() - start;
+    if (elapsed >= ms) {
+      return true;
+    }
+    uint32_t remaining = ms - elapsed;
+    int64_t until_deadline_us =
+        agenda_count > 0 ? agenda[0].deadline_us - getEpochUs() : INT64_MAX;
+    if (until_deadline_us > (int64_t)remaining * 1000) {
+      delay(remaining);
+      return true;
+    }
+    if (until_deadline_us > 1000) {
+      delay((uint32_t)(until_deadline_us / 1000) - 1);
+    }
+    // Spin the last millisecond, since delay() only has tick resolution.
+    while (agenda[0].deadline_us > getEpochUs()) {
+    }
+
+    bool was_stopped = stopped;
+    TickMode old_mode = current_mode;
+    uint32_t old_positioning_tick_ms = positioning_tick_ms;
+    serviceAgenda();
+    if (stopped != was_stopped || current_mode != old_mode ||
+        positioning_tick_ms != old_positioning_tick_ms) {
+      return false;
+    }
+  }
+}
+
+#ifdef SLEIGHT_PROFILE
+// Profiling builds also take commands typed on the serial console, one per
+// line, so the profile can be dumped without a broker.
+char serial_command[COMMAND_MAX_LENGTH];
+uint8_t serial_command_length = 0;
+
+static void pollSerialCommand() {
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c == '\r' || c == '\n') {
+      if (serial_command_length > 0) {
+        serial_command[serial_command_length] = '\0';
+        serial_command_length = 0;
+        dispatchCommand(serial_command);
+      }
+    } else if (serial_command_length < COMMAND_MAX_LENGTH - 1) {
+      serial_command[serial_command_length++] = c;
     }
-  } else {
-    logMessagef("Unknown command: %s", buffer);
   }
 }
+#endif
+
+static void onMqttMessage(char* topic, byte* payload, unsigned int length) {
+  PROFILE_SCOPE(mqtt_message);
+  if (strcmp(topic, MQTT_TOPIC_COMMAND) == 0) {
+    handleBinaryCommands(payload, length, getEpochUs());
+    return;
+  }
+  if (strcmp(topic, MQTT_TOPIC_MODE_SET) != 0) {
+    return;
+  }
+
+  char buffer[COMMAND_MAX_LENGTH];
+  if (length > sizeof(buffer) - 1) {
+    logMessagef("Command too long (%u bytes, max %u), ignored.", length,
+                (unsigned int)(sizeof(buffer) - 1));
+    return;
+  }
+  memcpy(buffer, payload, length);
+  buffer[length] = '\0';
+
+  dispatchCommand(buffer);
+}
 
 static void connectMqtt() {
+  PROFILE_SCOPE(mqtt_connect);
   if (strlen(mqtt_host) == 0) {
     return;
   }
@@ -597,6 +1816,7 @@ static void connectMqtt() {
   if (mqtt_client.connect("sleight-of-hand")) {
     logMessage("MQTT connected.");
     mqtt_client.subscribe(MQTT_TOPIC_MODE_SET);
+    mqtt_client.subscribe(MQTT_TOPIC_COMMAND);
     publishCurrentMode();
   } else {
     logMessagef("MQTT connection failed, rc=%d", mqtt_client.state());
@@ -613,8 +1833,34 @@ static void onSaveConfig() {
 
 // Called when the revolution completes (60 pulses done) to apply any pending
 // mode change before the idle gap.
+// Makes the queued mode current, logs how long after the command that
+// happened, and publishes it. at_boundary is true when the mode is applied for
+// the coming minute boundary rather than mid-minute.
+static void applyPendingModeChange(bool at_boundary) {
+  if (at_boundary && mode_change_requested_ms != 0) {
+    boundary_mode_commanded = true;
+  }
+  current_mode = pending_mode;
+  if (isTimekeeping(current_mode)) last_timekeeping_mode = current_mode;
+  mode_change_pending = false;
+  if (mode_change_requested_ms != 0) {
+    logMessagef("Mode changed to: %s (%lu ms after command)",
+                modeToString(current_mode),
+                (unsigned long)(millis() - mode_change_requested_ms));
+    mode_change_requested_ms = 0;
+  } else {
+    logMessagef("Mode changed to: %s", modeToString(current_mode));
+  }
+  publishCurrentMode();
+  // Reported once the new mode's first pulse fires.
+  if (mode_change_report.active) {
+    mode_change_report.applied = true;
+  }
+}
+
 static void onRevolutionComplete() {
   is_calibrate_sprint = false;
+  bridge_active = false;
 
   if (stop_at_top_pending) {
     stop_at_top_pending = false;
@@ -625,11 +1871,7 @@ static void onRevolutionComplete() {
 
   if (mode_change_pending) {
     TickMode old_mode = current_mode;
-    current_mode = pending_mode;
-    if (isTimekeeping(current_mode)) last_timekeeping_mode = current_mode;
-    mode_change_pending = false;
-    logMessagef("Mode changed to: %s", modeToString(current_mode));
-    publishCurrentMode();
+    applyPendingModeChange(true);
 
     // When switching from a positioning mode to a timekeeping mode, wait for
     // the next minute boundary to re-sync.
@@ -641,24 +1883,286 @@ static void onRevolutionComplete() {
   }
 }
 
+// Lets a timekeeping mode queued mid-minute take over from the next tick
+// instead of waiting for the boundary: fills its table and rescales the ticks
+// still to come so they end on the same boundary (see rescaleRemainingTicks()).
+// Returns false, leaving the change queued for onRevolutionComplete(), if the
+// new pattern doesn't fit the time left.
+static bool applyModeChangeMidMinute() {
+  if (last_pulse_start_us == 0) {
+    // Nothing to measure the time left from, e.g. right after "start".
+    return false;
+  }
+  int64_t last_pulse_us = lastPulseEpochUs();
+  int64_t boundary_us = (last_pulse_us / 60000000 + 1) * 60000000;
+  uint16_t table[TICK_COUNT];
+  fillTickTable(pending_mode, rush_wait_tick_ms, table, esp_random);
+  if (!rescaleRemainingTicks(table, (uint8_t)pulse_index,
+                             (uint32_t)((boundary_us - last_pulse_us) / 1000))) {
+    return false;
+  }
+  memcpy(tick_durations + pulse_index, table + pulse_index,
+         (TICK_COUNT - pulse_index) * sizeof(tick_durations[0]));
+  applyPendingModeChange(false);
+  return true;
+}
+
 // Called at each minute boundary to reset state for the new minute.
 static void startNewMinute() {
+  PROFILE_SCOPE(new_minute);
   pulse_index = 0;
 
   // At the top of every hour, pick a new random timekeeping mode before
   // filling the tick table. This means the new mode is in effect for the
   // entire new minute, with no wasted fill of the old mode's table.
   // Manual MQTT mode changes still work — they just get overridden at the
-  // next hour boundary.
+  // next hour boundary, unless they were applied for this very boundary.
   struct timeval tv;
   gettimeofday(&tv, nullptr);
   struct tm timeinfo;
   localtime_r(&tv.tv_sec, &timeinfo);
   if (timeinfo.tm_min == 0) {
-    selectRandomTimekeepingMode();
+    if (boundary_mode_commanded) {
+      logMessagef("Hourly random mode skipped: %s was commanded for this boundary.",
+                  modeToString(current_mode));
+    } else {
+      selectRandomTimekeepingMode();
+    }
   }
+  boundary_mode_commanded = false;
 
   fillTickDurations();
+  reportModeChangeEffect();
+}
+
+// --- Bridging ---
+
+// Shortest and longest average tick a bridge may use. Matches the range the
+// timekeeping tables already span (gravity's 500 ms to vetinari's 2001 ms), so
+// a bridge looks like ordinary ticking.
+constexpr uint32_t BRIDGE_MIN_TICK_MS = 500;
+constexpr uint32_t BRIDGE_MAX_TICK_MS = 2000;
+
+// Plans the pulses that take the hand from its current position to p59 so
+// that, with evenly spaced ticks, the next pulse after the bridge is the NTP
+// boundary pulse. Tries the next boundary first, then the one after; within
+// each, a plan that goes straight to p59 or one that adds a full revolution,
+// whichever keeps the average tick within BRIDGE_MIN/MAX_TICK_MS and closest
+// to 1000 ms. The last combination always fits, so a plan is always found.
+static void planBridge() {
+  int64_t now_us = getEpochUs();
+  // UTC_OFFSET_SECONDS is whole minutes, so epoch minutes line up with the
+  // minute boundaries getMsIntoMinute() sees.
+  int64_t next_boundary_us = (now_us / 60000000 + 1) * 60000000;
+  uint8_t direct_ticks = PULSES_PER_REVOLUTION - 1 - pulse_index;
+
+  bool found = false;
+  uint32_t best_error = 0;
+  for (uint8_t extra_minutes = 0; extra_minutes < 2 && !found; extra_minutes++) {
+    int64_t boundary_us = next_boundary_us + (int64_t)extra_minutes * 60000000;
+    uint32_t available_ms = (uint32_t)((boundary_us - now_us) / 1000);
+    for (uint8_t extra_revolutions = 0; extra_revolutions < 2; extra_revolutions++) {
+      uint8_t ticks = direct_ticks + extra_revolutions * PULSES_PER_REVOLUTION;
+      // ticks pulses plus the boundary pulse, evenly spaced.
+      uint32_t average_ms = available_ms / (ticks + 1);
+      if (average_ms < BRIDGE_MIN_TICK_MS || average_ms > BRIDGE_MAX_TICK_MS) {
+        continue;
+      }
+      uint32_t error = average_ms > 1000 ? average_ms - 1000 : 1000 - average_ms;
+      if (!found || error < best_error) {
+        found = true;
+        best_error = error;
+        bridge_ticks_remaining = ticks;
+        bridge_boundary_us = boundary_us;
+      }
+    }
+  }
+
+  bridge_active = true;
+  uint32_t span_ms = (uint32_t)((bridge_boundary_us - now_us) / 1000);
+  if (mode_change_requested_ms != 0) {
+    logMessagef("Bridging to %s: %u ticks over %lu ms (%lu ms after command)",
+                modeToString(pending_mode), bridge_ticks_remaining,
+                (unsigned long)span_ms,
+                (unsigned long)(millis() - mode_change_requested_ms));
+  } else {
+    logMessagef("Bridging to %s: %u ticks over %lu ms",
+                modeToString(pending_mode), bridge_ticks_remaining,
+                (unsigned long)span_ms);
+  }
+}
+
+// Delay after a bridge pulse that spreads the remaining time evenly over the
+// remaining ticks plus the boundary pulse. Recomputed every tick, so loop
+// jitter is absorbed instead of accumulated.
+static uint32_t bridgeDelayMs() {
+  int64_t pulse_start_us = getEpochUs() - (int64_t)PULSE_MS * 1000;
+  int64_t interval_us =
+      (bridge_boundary_us - pulse_start_us) / (bridge_ticks_remaining + 1);
+  int64_t delay_us = interval_us - (int64_t)PULSE_MS * 1000;
+  return delay_us > 0 ? (uint32_t)(delay_us / 1000) : 0;
+}
+
+// --- Benchmarks ---
+
+// The "bench" command times the hot paths on the target with the CPU cycle
+// counter; these are the RISC-V figures. The pure timing functions in
+// timing.h are also benchmarked on the host (the native-bench environment),
+// which catches regressions without a device but says nothing about cycles on
+// the C3. Each benchmark runs BENCH_ITERATIONS times and the minimum is
+// reported, which filters out interrupts and WiFi preemption. "bench save"
+// stores the minimums in the "bench" Preferences namespace as the baseline that
+// later runs are compared against.
+constexpr uint8_t BENCH_ITERATIONS = 32;
+constexpr uint32_t BENCH_REGRESSION_PERCENT = 10;
+
+volatile uint32_t bench_sink = 0;
+
+// fillTickDurations() without the sum check, into a scratch table so the
+// live one is untouched.
+static void benchFill(TickMode mode) {
+  uint16_t table[TICK_COUNT];
+  fillTickTable(mode, rush_wait_tick_ms, table, esp_random);
+  bench_sink += table[0];
+}
+
+static void benchMsIntoMinute() {
+  bench_sink += getMsIntoMinute();
+}
+
+// A text command through onMqttMessage(), the way the broker delivers it. An
+// unknown command falls through every comparison in handleCommand() and
+// stringToMode() before it is rejected, so this is the longest parse, and it
+// changes no state. Logging is muted, but the rejection is still formatted.
+static void benchParse() {
+  char topic[sizeof(MQTT_TOPIC_MODE_SET)];
+  memcpy(topic, MQTT_TOPIC_MODE_SET, sizeof(topic));
+  static const char payload[] = "bench unknown";
+  log_muted = true;
+  onMqttMessage(topic, (byte*)payload, sizeof(payload) - 1);
+  log_muted = false;
+}
+
+// The boundary log line, the one logged every minute while ticking: reading
+// the time, splitting it, and formatting it in logMessagef(). Sending is
+// muted; it depends on the network.
+static void benchFormat() {
+  log_muted = true;
+  logBoundaryPulse();
+  log_muted = false;
+}
+
+// One loop() iteration while stopped: OTA, the agenda, MQTT servicing and the
+// radio policy, everything a ticking iteration does besides its tick body. If
+// a command received meanwhile starts the clock, the remaining iterations are
+// skipped rather than letting the benchmark drive the coil.
+static void benchLoop() {
+  if (!stopped || start_at_minute_pending) {
+    return;
+  }
+  loop();
+}
+
+struct BenchmarkEntry {
+  const char* name;
+  void (*run)();
+};
+
+const BenchmarkEntry BENCHMARKS[] = {
+  {"fill_steady", [] { benchFill(TickMode::steady); }},
+  {"fill_rush_wait", [] { benchFill(TickMode::rush_wait); }},
+  {"fill_vetinari", [] { benchFill(TickMode::vetinari); }},
+  {"fill_hesitate", [] { benchFill(TickMode::hesitate); }},
+  {"fill_stumble", [] { benchFill(TickMode::stumble); }},
+  {"fill_gravity", [] { benchFill(TickMode::gravity); }},
+  {"ms_into_minute", benchMsIntoMinute},
+  {"parse", benchParse},
+  {"format", benchFormat},
+  {"loop", benchLoop},
+};
+constexpr uint8_t BENCHMARK_COUNT = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+
+// Bump whenever a BENCHMARKS[] entry changes what it measures without being
+// renamed. 1 was the first layout, which stored no version at all.
+constexpr uint32_t BENCH_LAYOUT_VERSION = 2;
+
+// Identifies the benchmark set a baseline was saved with: an FNV-1a hash of
+// BENCH_LAYOUT_VERSION and the benchmark names in order. A baseline with a
+// different layout is ignored rather than compared position by position.
+static uint32_t benchLayout() {
+  uint32_t hash = 2166136261u ^ BENCH_LAYOUT_VERSION;
+  hash *= 16777619u;
+  for (uint8_t b = 0; b < BENCHMARK_COUNT; b++) {
+    for (const char* c = BENCHMARKS[b].name; *c != '\0'; c++) {
+      hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+    // The terminating NUL, so "ab","c" and "a","bc" differ.
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Runs every benchmark and logs min/max cycles against the stored baseline.
+// Must only run while stopped, since it blocks loop() for the duration.
+static void runBenchmarks(bool save_baseline) {
+  bench_running = true;
+  uint32_t baseline[BENCHMARK_COUNT] = {};
+  uint32_t result[BENCHMARK_COUNT] = {};
+  uint32_t layout = benchLayout();
+  preferences.begin("bench", true);
+  bool has_baseline =
+      preferences.getBytes("baseline", baseline, sizeof(baseline)) == sizeof(baseline);
+  bool layout_matches = preferences.getUInt("layout", 0) == layout;
+  preferences.end();
+  if (has_baseline && !layout_matches) {
+    logMessage("bench: stored baseline is for a different benchmark set; ignoring it.");
+    has_baseline = false;
+  }
+
+  uint32_t cpu_mhz = ESP.getCpuFreqMHz();
+  uint8_t regressions = 0;
+  for (uint8_t b = 0; b < BENCHMARK_COUNT; b++) {
+    uint32_t min_cycles = UINT32_MAX;
+    uint32_t max_cycles = 0;
+    for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {
+      uint32_t start = ESP.getCycleCount();
+      BENCHMARKS[b].run();
+      uint32_t cycles = ESP.getCycleCount() - start;
+      min_cycles = min(min_cycles, cycles);
+      max_cycles = max(max_cycles, cycles);
+    }
+    result[b] = min_cycles;
+
+    if (has_baseline && baseline[b] != 0) {
+      int32_t delta_percent =
+          (int32_t)(((int64_t)min_cycles - baseline[b]) * 100 / baseline[b]);
+      bool regressed = min_cycles * 100 > baseline[b] * (100 + BENCH_REGRESSION_PERCENT);
+      if (regressed) {
+        regressions++;
+      }
+      logMessagef("bench %s min=%lu (%lu us) max=%lu baseline=%lu %+ld%%%s",
+                  BENCHMARKS[b].name, (unsigned long)min_cycles,
+                  (unsigned long)(min_cycles / cpu_mhz), (unsigned long)max_cycles,
+                  (unsigned long)baseline[b], (long)delta_percent,
+                  regressed ? " REGRESSION" : "");
+    } else {
+      logMessagef("bench %s min=%lu (%lu us) max=%lu", BENCHMARKS[b].name,
+                  (unsigned long)min_cycles, (unsigned long)(min_cycles / cpu_mhz),
+                  (unsigned long)max_cycles);
+    }
+  }
+
+  if (save_baseline) {
+    preferences.begin("bench", false);
+    preferences.putBytes("baseline", result, sizeof(result));
+    preferences.putUInt("layout", layout);
+    preferences.end();
+    logMessage("bench: baseline saved.");
+  } else if (has_baseline) {
+    logMessagef("bench: %u regression(s) over %lu%%.", regressions,
+                (unsigned long)BENCH_REGRESSION_PERCENT);
+  }
+  bench_running = false;
 }
 
 // --- Arduino entrypoints ---
@@ -678,7 +2182,20 @@ void setup() {
   preferences.begin("clock", true);
   String saved_host = preferences.getString("mqtt_host", "");
   mqtt_port = preferences.getUShort("mqtt_port", MQTT_DEFAULT_PORT);
+  uint8_t saved_policy = preferences.getUChar("radio_policy", (uint8_t)RadioPolicy::light);
+  radio_listen_interval =
+      preferences.getUChar("radio_listen", RADIO_LISTEN_INTERVAL_DEFAULT);
+  ramp_profile.start_ms = preferences.getUShort("ramp_start", 0);
+  ramp_profile.peak_ms = preferences.getUShort("ramp_peak", 0);
+  ramp_profile.steps = preferences.getUChar("ramp_steps", 0);
   preferences.end();
+  if (ramp_profile.steps > 0 && !rampProfileValid(ramp_profile)) {
+    // Saved by an older build that accepted any 16-bit start tick.
+    ramp_profile = {};
+  }
+  if (saved_policy <= (uint8_t)RadioPolicy::deep) {
+    radio_policy = (RadioPolicy)saved_policy;
+  }
   saved_host.toCharArray(mqtt_host, sizeof(mqtt_host));
 
   // WiFiManager with custom MQTT parameters.
@@ -711,6 +2228,16 @@ void setup() {
     logMessagef("Saved MQTT config: %s:%d", mqtt_host, mqtt_port);
   }
 
+  applyRadioListenInterval();
+  esp_wifi_set_ps(radioPolicyPsType(radio_policy));
+  radio_ps_applied = radioPolicyPsType(radio_policy);
+  resetRadioStats();
+  logMessagef("Radio policy: %s, listen interval %u",
+              radioPolicyToString(radio_policy), radio_listen_interval);
+
+  setupPulseTimer();
+  checkTimingCoreResidency();
+
   ArduinoOTA.setHostname("sleight-of-hand");
   ArduinoOTA.begin();
 
@@ -744,7 +2271,11 @@ void setup() {
 }
 
 void loop() {
-  ArduinoOTA.handle();
+  {
+    PROFILE_SCOPE(ota);
+    ArduinoOTA.handle();
+  }
+  serviceAgenda();
 
   // Check the minute boundary first, before any potentially-blocking MQTT
   // work. This ensures the boundary pulse fires as soon as the NTP second
@@ -768,17 +2299,39 @@ void loop() {
   if (!mqtt_client.connected() && stopped) {
     connectMqtt();
   }
-  mqtt_client.loop();
+  uint32_t service_ms = millis();
+  if (service_ms - mqtt_last_service_ms > mqtt_max_service_gap_ms &&
+      mqtt_last_service_ms != 0) {
+    mqtt_max_service_gap_ms = service_ms - mqtt_last_service_ms;
+  }
+  mqtt_last_service_ms = service_ms;
+  {
+    PROFILE_SCOPE(mqtt_loop);
+    mqtt_client.loop();
+  }
+  updateRadioPower();
+#ifdef SLEIGHT_PROFILE
+  pollSerialCommand();
+  if (profile_dump_pending) {
+    profile_dump_pending = false;
+    dumpProfile();
+  }
+#endif
+
+  serviceStressNvs();
+
+  if (bench_pending) {
+    bench_pending = false;
+    if (stopped && !start_at_minute_pending) {
+      runBenchmarks(bench_save_pending);
+    }
+  }
 
   if (start_at_minute_pending) {
     // Poll NTP until the second rolls over to 0, then start.
     if (getMsIntoMinute() < 1000) {
       if (mode_change_pending) {
-        current_mode = pending_mode;
-        if (isTimekeeping(current_mode)) last_timekeeping_mode = current_mode;
-        mode_change_pending = false;
-        logMessagef("Mode changed to: %s", modeToString(current_mode));
-        publishCurrentMode();
+        applyPendingModeChange(true);
       }
       if (!isTimekeeping(current_mode)) {
         // If the user was in a positioning mode when the minute boundary fires,
@@ -809,9 +2362,27 @@ void loop() {
 
   if (isTimekeeping(current_mode)) {
     if (pulse_index < 59) {
+      if (mode_change_pending && isTimekeeping(pending_mode)) {
+        applyModeChangeMidMinute();
+      }
+      // The pulse is armed a whole tick ahead, so only the timer alarm has to
+      // be on time; loop() just waits for it.
       uint16_t duration = tick_durations[pulse_index];
-      delay(duration - PULSE_MS);
-      pulseOnce();
+      int64_t previous_start_us = last_pulse_start_us;
+      int64_t start_us = previous_start_us == 0
+                             ? esp_timer_get_time() + (int64_t)(duration - PULSE_MS) * 1000
+                             : previous_start_us + (int64_t)duration * 1000;
+      armPulse(start_us);
+      int64_t until_start_us = start_us - esp_timer_get_time();
+      if (!delayWithAgenda(until_start_us > 0 ? (uint32_t)(until_start_us / 1000) : 0) &&
+          cancelPulse()) {
+        // A scheduled command stopped the clock or switched modes mid-tick;
+        // loop() picks up the new state on its next iteration.
+        return;
+      }
+      completePulse();
+      recordTickLateness(previous_start_us, duration);
+      reportModeChangeEffect();
     }
     // pulse_index == 59: the boundary check at the top of loop() handles this
     // case; nothing to do here.
@@ -820,29 +2391,52 @@ void loop() {
     // Both modes share the same structure; only the tick duration differs,
     // and that is already stored in positioning_tick_ms.
 
-    // When the hand is one pulse away from completing a revolution AND a
-    // timekeeping mode change is pending, skip the final pulse (p59→p00) so
-    // the hand stops at p59. start_at_minute_pending will then fire the
-    // p59→p00 boundary pulse at the correct NTP moment. Without this check,
-    // the revolution would complete to p00, violating the invariant that the
-    // hand is always at p59 when start_at_minute_pending fires.
+    // When a timekeeping mode change is pending, the remaining ticks become a
+    // bridge: evenly spaced pulses that bring the hand to p59 one interval
+    // before an NTP minute boundary (see planBridge()). When the bridge has
+    // no ticks left, onRevolutionComplete() applies the mode and
+    // start_at_minute_pending fires the p59→p00 boundary pulse at the correct
+    // NTP moment, keeping the invariant that the hand is always at p59 when
+    // start_at_minute_pending fires.
     //
     // Calibrate sprints are excluded: they set pulse_index = position + 1
-    // (one ahead of the actual hand position), so this check would fire one
+    // (one ahead of the actual hand position), so a bridge would stop one
     // pulse too early (hand at p58 instead of p59). The existing
     // pulse_index >= PULSES_PER_REVOLUTION wrap handles calibrate sprints
     // correctly (the sprint fires exactly enough pulses to land at p59).
-    if (!is_calibrate_sprint && !stop_at_top_pending &&
-        pulse_index == PULSES_PER_REVOLUTION - 1 &&
-        mode_change_pending && isTimekeeping(pending_mode)) {
+    bool bridging = !is_calibrate_sprint && !stop_at_top_pending &&
+                    mode_change_pending && isTimekeeping(pending_mode);
+    if (!bridging) {
+      bridge_active = false;
+    } else if (!bridge_active || getEpochUs() >= bridge_boundary_us) {
+      planBridge();
+    }
+
+    if (bridging && bridge_ticks_remaining == 0) {
       onRevolutionComplete();
       return;
     }
 
     pulseOnce();
-    delay(positioning_tick_ms - PULSE_MS);
+    if (bridging) {
+      bridge_ticks_remaining--;
+      // After the last bridge pulse, loop() goes straight to the boundary
+      // wait instead of sleeping here.
+      if (bridge_ticks_remaining > 0) {
+        delayWithAgenda(bridgeDelayMs());
+      }
+    } else {
+      if (ramp_ticks_done < UINT16_MAX) {
+        ramp_ticks_done++;
+      }
+      delayWithAgenda(currentPositioningTickMs() - PULSE_MS);
+    }
     if (pulse_index >= PULSES_PER_REVOLUTION) {
-      onRevolutionComplete();
+      // A bridge may run through p00 on its way to p59; that is not the end
+      // of a revolution for onRevolutionComplete()'s purposes.
+      if (!bridging) {
+        onRevolutionComplete();
+      }
       pulse_index = 0;
     }
   }
@@ -0,0 +1,30 @@
+// Host benchmark baseline: time per call as a multiple of the reference loop
+// in test_main.cpp, recorded with "pio test -e native-bench -v" on an x86-64
+// Linux host with g++ -O2, taking the median of eight runs. Ratios carry over
+// between similar hosts far better than nanoseconds do. Re-record it by pasting
+// the lines the run prints when the compiler changes, or when a change makes a
+// benchmark faster on purpose.
+#pragma once
+
+#include <stdint.h>
+
+// Looser than the on-device BENCH_REGRESSION_PERCENT: the ratios of the
+// shortest benchmarks still moved by up to a third between runs on an idle
+// host.
+constexpr uint32_t HOST_BENCH_REGRESSION_PERCENT = 40;
+
+struct BenchBaseline {
+  const char* name;
+  double ratio;
+};
+
+constexpr BenchBaseline HOST_BENCH_BASELINE[] = {
+  {"fill_steady", 0.184},
+  {"fill_rush_wait", 0.184},
+  {"fill_vetinari", 1.064},
+  {"fill_hesitate", 1.092},
+  {"fill_stumble", 1.093},
+  {"fill_gravity", 0.163},
+  {"ms_into_minute", 0.019},
+  {"ramp_revolution", 0.725},
+};
@@ -0,0 +1,163 @@
+// Host benchmarks for the pure timing functions in timing.h, compared against
+// baseline.h. Run with: pio test -e native-bench -v
+//
+// Every time is divided by a reference loop timed in the same run, so the
+// baseline holds ratios rather than nanoseconds and carries over between
+// hosts. Even so, a virtual machine can slow one benchmark by half for a whole
+// run, so the run only reports unless SLEIGHT_BENCH_ENFORCE=1 is set, in
+// which case a regression fails it. Enforce it on a quiet, dedicated host.
+//
+// These catch regressions in the shared math without a device. Cycle counts on
+// the ESP32-C3 come from the "bench" MQTT command instead, which also covers
+// the paths that need the hardware (command parsing, logging, loop()).
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <timing.h>
+#include <unity.h>
+
+#include "baseline.h"
+
+// Each benchmark is timed BENCH_SAMPLES times over BENCH_REPEATS calls, and the
+// fastest sample is kept, which filters out preemption by the host OS.
+constexpr int BENCH_SAMPLES = 50;
+constexpr int BENCH_REPEATS = 2000;
+
+constexpr RampProfile README_RAMP = {300, 60, 8};
+
+volatile uint32_t bench_sink = 0;
+uint32_t random_state = 0x12345678;
+
+// xorshift32 standing in for esp_random(), so every run shuffles the same way.
+static uint32_t benchRandom() {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return random_state;
+}
+
+// The yardstick: a table fill of the same size done without timing.h, so it
+// tracks the host's speed but not changes to the code under test.
+static void benchReference() {
+  uint16_t table[TICK_COUNT];
+  for (uint8_t i = 0; i < TICK_COUNT; i++) {
+    table[i] = (uint16_t)benchRandom();
+  }
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < TICK_COUNT; i++) {
+    sum += table[i];
+  }
+  bench_sink += sum;
+}
+
+static void benchFill(TickMode mode) {
+  uint16_t table[TICK_COUNT];
+  fillTickTable(mode, 700, table, benchRandom);
+  bench_sink += table[0];
+}
+
+static void benchMsIntoMinute() {
+  static int64_t epoch_us = 1767225600000000LL;
+  epoch_us += 1234567;
+  bench_sink += msIntoMinute(epoch_us);
+}
+
+static void benchRampRevolution() {
+  bench_sink += rampRevolutionMs(README_RAMP, 60);
+}
+
+struct BenchmarkEntry {
+  const char* name;
+  void (*run)();
+};
+
+const BenchmarkEntry BENCHMARKS[] = {
+  {"fill_steady", [] { benchFill(TickMode::steady); }},
+  {"fill_rush_wait", [] { benchFill(TickMode::rush_wait); }},
+  {"fill_vetinari", [] { benchFill(TickMode::vetinari); }},
+  {"fill_hesitate", [] { benchFill(TickMode::hesitate); }},
+  {"fill_stumble", [] { benchFill(TickMode::stumble); }},
+  {"fill_gravity", [] { benchFill(TickMode::gravity); }},
+  {"ms_into_minute", benchMsIntoMinute},
+  {"ramp_revolution", benchRampRevolution},
+};
+
+static double sampleNs(void (*run)()) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_REPEATS; i++) {
+    run();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / BENCH_REPEATS;
+}
+
+// Time per call relative to benchReference(). The two are sampled in turn, so
+// a change in clock speed partway through affects both.
+static double fastestRatio(void (*run)()) {
+  double best_ns = 0;
+  double best_reference_ns = 0;
+  for (int sample = 0; sample < BENCH_SAMPLES; sample++) {
+    double reference_ns = sampleNs(benchReference);
+    double ns = sampleNs(run);
+    if (sample == 0 || reference_ns < best_reference_ns) {
+      best_reference_ns = reference_ns;
+    }
+    if (sample == 0 || ns < best_ns) {
+      best_ns = ns;
+    }
+  }
+  return best_ns / best_reference_ns;
+}
+
+static bool enforced() {
+  const char* value = getenv("SLEIGHT_BENCH_ENFORCE");
+  return value != nullptr && strcmp(value, "1") == 0;
+}
+
+static const BenchBaseline* findBaseline(const char* name) {
+  for (const BenchBaseline& baseline : HOST_BENCH_BASELINE) {
+    if (strcmp(baseline.name, name) == 0) {
+      return &baseline;
+    }
+  }
+  return nullptr;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+// Prints one line per benchmark in baseline.h's format, so a new baseline can
+// be pasted straight in. Fails on a regression only when enforced.
+static void test_no_regressions() {
+  int regressions = 0;
+  for (const BenchmarkEntry& benchmark : BENCHMARKS) {
+    double ratio = fastestRatio(benchmark.run);
+    const BenchBaseline* baseline = findBaseline(benchmark.name);
+    if (baseline == nullptr) {
+      printf("  {\"%s\", %.3f},  // no baseline\n", benchmark.name, ratio);
+      continue;
+    }
+    bool regressed = ratio * 100 > baseline->ratio * (100 + HOST_BENCH_REGRESSION_PERCENT);
+    if (regressed) {
+      regressions++;
+    }
+    printf("  {\"%s\", %.3f},  // baseline %.3f, %+.0f%%%s\n", benchmark.name, ratio,
+           baseline->ratio, (ratio - baseline->ratio) * 100 / baseline->ratio,
+           regressed ? " REGRESSION" : "");
+  }
+  if (!enforced()) {
+    printf("  %d regression(s); set SLEIGHT_BENCH_ENFORCE=1 to fail on them\n",
+           regressions);
+    return;
+  }
+  TEST_ASSERT_EQUAL(0, regressions);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_regressions);
+  return UNITY_END();
+}
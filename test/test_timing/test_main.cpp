@@ -0,0 +1,164 @@
+// Host tests for the timing math in timing.h. Run with: pio test -e native
+#include <string.h>
+#include <timing.h>
+#include <unity.h>
+
+// The profile from the README: start at 300 ms, reach 60 ms after 8 ticks.
+constexpr RampProfile README_RAMP = {300, 60, 8};
+
+static uint32_t fixedRandom() {
+  return 7;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+static void test_no_ramp_is_constant() {
+  RampProfile off = {};
+  for (uint32_t i = 0; i < PULSES_PER_REVOLUTION; i++) {
+    TEST_ASSERT_EQUAL_UINT32(200, positioningTickMs(off, 200, i, RAMP_DISTANCE_UNKNOWN));
+  }
+  TEST_ASSERT_EQUAL_UINT32(200 * PULSES_PER_REVOLUTION, rampRevolutionMs(off, 200));
+}
+
+static void test_ramp_accelerates_to_cruise() {
+  TEST_ASSERT_EQUAL_UINT32(300, positioningTickMs(README_RAMP, 60, 0, RAMP_DISTANCE_UNKNOWN));
+  TEST_ASSERT_EQUAL_UINT32(300, positioningTickMs(README_RAMP, 60, 1, RAMP_DISTANCE_UNKNOWN));
+  uint32_t previous = 300;
+  for (uint32_t done = 2; done <= README_RAMP.steps; done++) {
+    uint32_t tick = positioningTickMs(README_RAMP, 60, done, RAMP_DISTANCE_UNKNOWN);
+    TEST_ASSERT_LESS_THAN_UINT32(previous, tick);
+    TEST_ASSERT_GREATER_THAN_UINT32(60, tick);
+    previous = tick;
+  }
+  TEST_ASSERT_EQUAL_UINT32(60, positioningTickMs(README_RAMP, 60, 9, RAMP_DISTANCE_UNKNOWN));
+  TEST_ASSERT_EQUAL_UINT32(60, positioningTickMs(README_RAMP, 60, 500, RAMP_DISTANCE_UNKNOWN));
+}
+
+static void test_full_revolution_is_symmetric() {
+  uint32_t ticks[PULSES_PER_REVOLUTION];
+  for (uint32_t i = 0; i < PULSES_PER_REVOLUTION; i++) {
+    ticks[i] = positioningTickMs(README_RAMP, 60, i + 1, PULSES_PER_REVOLUTION - i);
+  }
+  for (uint32_t i = 0; i < PULSES_PER_REVOLUTION; i++) {
+    TEST_ASSERT_EQUAL_UINT32(ticks[i], ticks[PULSES_PER_REVOLUTION - 1 - i]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(300, ticks[0]);
+  TEST_ASSERT_EQUAL_UINT32(60, ticks[PULSES_PER_REVOLUTION / 2]);
+}
+
+static void test_full_revolution_total() {
+  // 8 ramp ticks each way plus 44 at the 60 ms peak, against 12000 ms for a
+  // constant 200 ms calibrate sprint.
+  TEST_ASSERT_EQUAL_UINT32(4832, rampRevolutionMs(README_RAMP, 60));
+}
+
+static void test_short_move_is_triangular() {
+  // Six ticks to go: steps 0, 1, 2, 2, 1, 0, turning around well before the
+  // 8-step ramp reaches the peak.
+  uint32_t ticks[6];
+  for (uint32_t i = 0; i < 6; i++) {
+    ticks[i] = positioningTickMs(README_RAMP, 60, i + 1, 6 - i);
+    TEST_ASSERT_GREATER_THAN_UINT32(60, ticks[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(300, ticks[0]);
+  TEST_ASSERT_EQUAL_UINT32(ticks[0], ticks[5]);
+  TEST_ASSERT_EQUAL_UINT32(ticks[1], ticks[4]);
+  TEST_ASSERT_EQUAL_UINT32(ticks[2], ticks[3]);
+  TEST_ASSERT_LESS_THAN_UINT32(ticks[1], ticks[2]);
+  TEST_ASSERT_EQUAL_UINT32(rampTickMs(README_RAMP, 60, 2), ticks[2]);
+}
+
+static void test_slow_cruise_is_never_ramped() {
+  // Crawl is slower than any start tick.
+  TEST_ASSERT_EQUAL_UINT32(2000, positioningTickMs(README_RAMP, 2000, 1, RAMP_DISTANCE_UNKNOWN));
+}
+
+static void test_large_products_do_not_overflow() {
+  // 65535 * 10924 * 30 needs 35 bits; in 32 bits this came out as a 6 ms
+  // tick, shorter than the pulse itself.
+  RampProfile wide = {65535, 60, 30};
+  for (uint32_t step = 0; step < wide.steps; step++) {
+    uint32_t tick = rampTickMs(wide, 10924, step);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(10924, tick);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(65535, tick);
+  }
+  TEST_ASSERT_EQUAL_UINT32(65535, rampTickMs(wide, 10924, 0));
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(PULSE_MS,
+                                      positioningTickMs(wide, 10924, 5, RAMP_DISTANCE_UNKNOWN));
+}
+
+static void test_profile_limits() {
+  TEST_ASSERT_TRUE(rampProfileValid(README_RAMP));
+  TEST_ASSERT_TRUE(rampProfileValid({RAMP_MAX_START_MS, RAMP_MIN_PEAK_MS, RAMP_MAX_STEPS}));
+  TEST_ASSERT_FALSE(rampProfileValid({65535, 60, 30}));
+  TEST_ASSERT_FALSE(rampProfileValid({300, 39, 8}));
+  TEST_ASSERT_FALSE(rampProfileValid({50, 60, 8}));
+  TEST_ASSERT_FALSE(rampProfileValid({300, 60, 0}));
+  TEST_ASSERT_FALSE(rampProfileValid({300, 60, RAMP_MAX_STEPS + 1}));
+}
+
+static void test_rescale_keeps_natural_timing() {
+  // Half a minute into steady, switching to steady changes nothing.
+  uint16_t table[TICK_COUNT];
+  fillTickTable(TickMode::steady, 700, table, fixedRandom);
+  TEST_ASSERT_TRUE(rescaleRemainingTicks(table, 30, 29 * 1000 + 1000));
+  for (uint8_t i = 30; i < TICK_COUNT; i++) {
+    TEST_ASSERT_EQUAL_UINT16(1000, table[i]);
+  }
+}
+
+static void test_rescale_fits_time_left() {
+  // Gravity taking over at tick 40 with 20 s to go: its rising ticks shrink
+  // but keep their shape, and still leave idle before the boundary.
+  uint16_t table[TICK_COUNT];
+  fillTickTable(TickMode::gravity, 700, table, fixedRandom);
+  TEST_ASSERT_TRUE(rescaleRemainingTicks(table, 40, 20000));
+  uint32_t remaining_ms = 0;
+  for (uint8_t i = 40; i < TICK_COUNT; i++) {
+    TEST_ASSERT_EQUAL_UINT16(table[40], table[i]);
+    remaining_ms += table[i];
+  }
+  TEST_ASSERT_EQUAL_UINT16(1520 * 20000 / (19 * 1520 + 920), table[40]);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(20000, remaining_ms);
+  TEST_ASSERT_GREATER_THAN_UINT32(20000 - 920, remaining_ms);
+  TEST_ASSERT_EQUAL_UINT16(500, table[0]);
+}
+
+static void test_rescale_refuses_to_squeeze() {
+  // Vetinari with 3 s left for 10 ticks would need ticks under 200 ms.
+  uint16_t table[TICK_COUNT];
+  fillTickTable(TickMode::vetinari, 700, table, fixedRandom);
+  uint16_t before[TICK_COUNT];
+  memcpy(before, table, sizeof(table));
+  TEST_ASSERT_FALSE(rescaleRemainingTicks(table, 49, 3000));
+  TEST_ASSERT_EQUAL(0, memcmp(before, table, sizeof(table)));
+  TEST_ASSERT_FALSE(rescaleRemainingTicks(table, TICK_COUNT, 1000));
+}
+
+static void test_ms_into_minute_wraps_at_boundary() {
+  // 2026-01-01 00:00:00 UTC, a minute boundary.
+  constexpr int64_t BOUNDARY_US = 1767225600LL * 1000000;
+  TEST_ASSERT_EQUAL_UINT32(0, msIntoMinute(BOUNDARY_US));
+  TEST_ASSERT_EQUAL_UINT32(59999, msIntoMinute(BOUNDARY_US - 1));
+  TEST_ASSERT_EQUAL_UINT32(0, msIntoMinute(BOUNDARY_US + 999));
+  TEST_ASSERT_EQUAL_UINT32(30500, msIntoMinute(BOUNDARY_US + 90500000));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_ramp_is_constant);
+  RUN_TEST(test_ramp_accelerates_to_cruise);
+  RUN_TEST(test_full_revolution_is_symmetric);
+  RUN_TEST(test_full_revolution_total);
+  RUN_TEST(test_short_move_is_triangular);
+  RUN_TEST(test_slow_cruise_is_never_ramped);
+  RUN_TEST(test_large_products_do_not_overflow);
+  RUN_TEST(test_profile_limits);
+  RUN_TEST(test_rescale_keeps_natural_timing);
+  RUN_TEST(test_rescale_fits_time_left);
+  RUN_TEST(test_rescale_refuses_to_squeeze);
+  RUN_TEST(test_ms_into_minute_wraps_at_boundary);
+  return UNITY_END();
+}